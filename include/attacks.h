@@ -0,0 +1,154 @@
+/**
+ * @file attacks.h
+ * @author Seán Rourke
+ * @brief Precomputed attack tables for leaping pieces and, using magic bitboards, sliding pieces.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef ATTACKS_H
+#define ATTACKS_H
+
+#include "board.h"
+
+/**
+ * @struct Magic
+ * @brief Magic bitboard lookup data for a single square.
+ *
+ * The relevant occupancy is masked, multiplied by the magic number and shifted
+ * down to give an index into the square's slice of the attack table.
+ */
+struct Magic
+{
+    Bitboard mask;       ///< Relevant occupancy squares (board edges excluded).
+    Bitboard magic;      ///< Magic multiplier mapping occupancies to table indices.
+    Bitboard *attacks;   ///< Start of this square's slice of the attack table.
+    unsigned int shift;  ///< 64 minus the number of relevant occupancy bits.
+
+    /**
+     * @brief Computes the attack table index for a given occupancy.
+     *
+     * @param occupancy The occupied squares on the board.
+     * @return unsigned int The index into this square's attack table slice.
+     */
+    unsigned int index(Bitboard occupancy) const
+    {
+        return static_cast<unsigned int>(((occupancy & mask) * magic) >> shift);
+    }
+};
+
+extern std::array<Magic, 64> bishopMagics; ///< Bishop magic lookup data for each square.
+extern std::array<Magic, 64> rookMagics;   ///< Rook magic lookup data for each square.
+
+extern std::array<Bitboard, 64> knightAttackTable;                        ///< Knight attacks from each square.
+extern std::array<Bitboard, 64> kingAttackTable;                          ///< King attacks from each square.
+extern std::array<std::array<Bitboard, 64>, MAX_COLOUR> pawnAttackTable; ///< Pawn captures from each square, by pawn colour.
+extern std::array<std::array<Bitboard, 64>, 64> betweenTable;             ///< Squares strictly between two aligned squares.
+extern std::array<std::array<Bitboard, 64>, 64> lineTable;                ///< Full line through two aligned squares.
+
+/**
+ * @brief Builds the leaper and magic bitboard attack tables.
+ *
+ * Must be called once at startup before any attacks are looked up.
+ */
+void initialiseAttackTables();
+
+/**
+ * @brief Looks up the squares attacked by a knight.
+ *
+ * @param square The square the knight is on.
+ * @return Bitboard The attacked squares.
+ */
+inline Bitboard knightAttacks(int square)
+{
+    return knightAttackTable[square];
+}
+
+/**
+ * @brief Looks up the squares attacked by a king.
+ *
+ * @param square The square the king is on.
+ * @return Bitboard The attacked squares.
+ */
+inline Bitboard kingAttacks(int square)
+{
+    return kingAttackTable[square];
+}
+
+/**
+ * @brief Looks up the squares attacked by a pawn.
+ *
+ * @param colour The colour of the pawn.
+ * @param square The square the pawn is on.
+ * @return Bitboard The squares the pawn attacks diagonally forward.
+ */
+inline Bitboard pawnAttacks(Colour colour, int square)
+{
+    return pawnAttackTable[colour][square];
+}
+
+/**
+ * @brief Looks up the squares strictly between two squares on a shared rank, file or diagonal.
+ *
+ * @param from The first square.
+ * @param to The second square.
+ * @return Bitboard The squares between them, or 0 if they are not aligned.
+ */
+inline Bitboard betweenBB(int from, int to)
+{
+    return betweenTable[from][to];
+}
+
+/**
+ * @brief Looks up the whole rank, file or diagonal passing through two squares.
+ *
+ * @param from The first square.
+ * @param to The second square.
+ * @return Bitboard The line through both squares, or 0 if they are not aligned.
+ */
+inline Bitboard lineBB(int from, int to)
+{
+    return lineTable[from][to];
+}
+
+/**
+ * @brief Looks up the squares attacked by a bishop.
+ *
+ * @param square The square the bishop is on.
+ * @param occupancy The occupied squares on the board.
+ * @return Bitboard The attacked squares, including the first blocker in each direction.
+ */
+inline Bitboard bishopAttacks(int square, Bitboard occupancy)
+{
+    const Magic &m = bishopMagics[square];
+    return m.attacks[m.index(occupancy)];
+}
+
+/**
+ * @brief Looks up the squares attacked by a rook.
+ *
+ * @param square The square the rook is on.
+ * @param occupancy The occupied squares on the board.
+ * @return Bitboard The attacked squares, including the first blocker in each direction.
+ */
+inline Bitboard rookAttacks(int square, Bitboard occupancy)
+{
+    const Magic &m = rookMagics[square];
+    return m.attacks[m.index(occupancy)];
+}
+
+/**
+ * @brief Looks up the squares attacked by a queen.
+ *
+ * @param square The square the queen is on.
+ * @param occupancy The occupied squares on the board.
+ * @return Bitboard The attacked squares, including the first blocker in each direction.
+ */
+inline Bitboard queenAttacks(int square, Bitboard occupancy)
+{
+    return bishopAttacks(square, occupancy) | rookAttacks(square, occupancy);
+}
+
+#endif
@@ -14,18 +14,22 @@
 #include <array>
 #include <iostream>
 #include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 using Bitboard = uint64_t; ///< Defines a bitboard as a 64 bit integer.
 
 const int BOARD_SIZE = 8; ///< Number of ranks and files in a standard chessboard.
 
+const std::string START_FEN = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"; ///< FEN of the standard starting position.
+
 /**
  * @enum Piece
  * @brief Represents different types of chess pieces
  */
-enum Piece
+enum Piece : int8_t
 {
     PAWN,          ///< Represents a pawn.
     KNIGHT,        ///< Represents a knight.
@@ -42,41 +46,91 @@ const Piece EMPTY = static_cast<Piece>(-1); ///< Empty piece for empty squares.
  * @enum Colour
  * @brief Represents the colour of a chess piece.
  */
-enum Colour
+enum Colour : uint8_t
 {
     WHITE,     ///< Represents white pieces.
     BLACK,     ///< Represents black pieces.
     MAX_COLOUR ///< Colour count.
 };
 
+/**
+ * @enum CastlingRight
+ * @brief Bit flags for each castling right, combined into a four bit mask.
+ */
+enum CastlingRight : uint8_t
+{
+    WHITE_KINGSIDE = 1,  ///< White may castle kingside.
+    WHITE_QUEENSIDE = 2, ///< White may castle queenside.
+    BLACK_KINGSIDE = 4,  ///< Black may castle kingside.
+    BLACK_QUEENSIDE = 8, ///< Black may castle queenside.
+    ALL_CASTLING = 15    ///< Every castling right.
+};
+
+/**
+ * @brief A piece and its colour packed into one byte for the mailbox: the
+ * piece type in the low three bits and the colour in bit three.
+ */
+using PieceCode = int8_t;
+
+const PieceCode NO_PIECE = -1; ///< Mailbox value for an empty square.
+
+/**
+ * @brief Packs a piece type and colour into a mailbox code.
+ *
+ * @param piece The piece type.
+ * @param colour The colour of the piece.
+ * @return PieceCode The packed piece.
+ */
+inline PieceCode makePieceCode(Piece piece, Colour colour)
+{
+    return static_cast<PieceCode>(piece | (colour << 3));
+}
+
+/**
+ * @struct PieceSquareScore
+ * @brief Material and piece placement summed over the board, from white's point of view.
+ */
+struct PieceSquareScore
+{
+    int16_t middlegame = 0; ///< Sum of the middlegame table values.
+    int16_t endgame = 0;    ///< Sum of the endgame table values.
+    int16_t phase = 0;      ///< Game phase from the non-pawn material left (0 with only pawns and kings).
+
+    bool operator==(const PieceSquareScore &other) const
+    {
+        return middlegame == other.middlegame && endgame == other.endgame && phase == other.phase;
+    }
+};
+
 /**
  * @class Board
  * @brief Represents a chessboard using bitboards.
  *
- * Manages the board representation of a chessboard using bitboards.
+ * Manages the board representation of a chessboard using bitboards. The
+ * bitboards and the small state fields used by move generation are packed
+ * into the first two cache lines; the key and mailbox, touched mostly by
+ * makeMove, follow them.
  */
-class Board
+class alignas(64) Board
 {
 public:
     /**
-     * @brief Stores bitboards for each piece type and colour.
-     * bitboard[Piece][Colour] gives the bitboard for that piece-colour combination.
+     * @brief Stores bitboards for each colour and piece type.
+     * bitboards[Colour][Piece] gives the bitboard for that colour-piece combination.
      */
-    std::array<std::array<Bitboard, MAX_COLOUR>, MAX_PIECE_TYPE> bitboards = {};
-    Bitboard allPieces = 0;   ///< Bitboard containing all occupied squares.
-    Bitboard whitePieces = 0; ///< Bitboard containing all white pieces.
-    Bitboard blackPieces = 0; ///< Bitboard containing all black pieces.
-    int enPassantSquare = -1; ///< Stores location of valid en passant square (-1 if none).
-    std::array<Piece, 64> pieces;
-    Colour currentColour = WHITE;
-
-    bool whiteCanCastleKingSide;
-    bool whiteCanCastleQueenSide;
-    bool blackCanCastleKingSide;
-    bool blackCanCastleQueenSide;
-
-    bool whiteHasCastled;
-    bool blackHasCastled;
+    std::array<std::array<Bitboard, MAX_PIECE_TYPE>, MAX_COLOUR> bitboards = {};
+    std::array<Bitboard, MAX_COLOUR> colourPieces = {}; ///< Bitboards containing all pieces of each colour.
+    Bitboard allPieces = 0;                              ///< Bitboard containing all occupied squares.
+    int8_t enPassantSquare = -1;                         ///< Stores location of valid en passant square (-1 if none).
+    uint8_t castlingRights = ALL_CASTLING;               ///< CastlingRight flags still available.
+    Colour currentColour = WHITE;                        ///< The side to move.
+    std::array<bool, MAX_COLOUR> hasCastled = {};        ///< Whether each side has castled (or moved its king).
+
+    uint64_t hashKey = 0;               ///< Zobrist key of the position, updated incrementally by makeMove.
+    uint64_t pawnKey = 0;               ///< Zobrist key of the pawns alone, updated incrementally by makeMove.
+    PieceSquareScore pieceSquareScore; ///< Material and placement, updated incrementally by makeMove.
+
+    std::array<PieceCode, 64> mailbox; ///< The piece on each square (NO_PIECE if empty).
 
     /**
      * @brief Construct a new Board object.
@@ -89,7 +143,18 @@ public:
     void initialise();
 
     /**
-     * @brief Updates aggregate bitboards.
+     * @brief Sets up the board from a position in Forsyth-Edwards Notation.
+     *
+     * @param fen The FEN string. The halfmove and fullmove counters are optional and ignored.
+     * @throws std::invalid_argument If the FEN string is malformed. The board is then left unchanged.
+     */
+    void loadFEN(const std::string &fen);
+
+    /**
+     * @brief Rebuilds the colour and occupancy bitboards from the piece bitboards.
+     *
+     * Only needed when setting up a position; makeMove and unmakeMove update
+     * them incrementally.
      */
     void updateAggregateBitboards();
 
@@ -112,6 +177,59 @@ public:
      * @return The location of the king.
      */
     int kingSquare(Colour colour) const;
+
+    /**
+     * @brief Gives the type of piece on a square.
+     *
+     * @param square The square to look at.
+     * @return Piece The piece type, or EMPTY if the square is empty.
+     */
+    Piece pieceOn(int square) const
+    {
+        PieceCode code = mailbox[square];
+        return (code == NO_PIECE) ? EMPTY : static_cast<Piece>(code & 7);
+    }
+
+    /**
+     * @brief Gives the colour of the piece on an occupied square.
+     *
+     * @param square The square to look at, which must not be empty.
+     * @return Colour The colour of the piece.
+     */
+    Colour colourOn(int square) const { return static_cast<Colour>((mailbox[square] >> 3) & 1); }
+
+    /**
+     * @brief Finds every piece of either colour attacking a square.
+     *
+     * @param square The square being attacked.
+     * @param occupancy The occupied squares used to block sliding pieces.
+     * @return Bitboard The squares of all attacking pieces.
+     */
+    Bitboard attackersTo(int square, Bitboard occupancy) const;
+
+    /**
+     * @brief Computes the Zobrist key of the position from scratch.
+     *
+     * @return uint64_t The Zobrist key.
+     */
+    uint64_t computeHash() const;
+
+    /**
+     * @brief Computes the Zobrist key of the pawns alone from scratch.
+     *
+     * @return uint64_t The pawn key (0 if there are no pawns).
+     */
+    uint64_t computePawnKey() const;
+
+    /**
+     * @brief Sums the material and piece-square values of the position from scratch.
+     *
+     * @return PieceSquareScore The material, placement and game phase.
+     */
+    PieceSquareScore computePieceSquareScore() const;
 };
 
+static_assert(sizeof(Board) <= 256, "Board should fit in four cache lines");
+static_assert(offsetof(Board, hashKey) <= 128, "Bitboards and move generation state should fit in two cache lines");
+
 #endif
@@ -12,53 +12,41 @@
 #define EVALUATION_H
 
 #include "board.h"
+#include "pawnStructure.h"
+#include "score.h"
 
 /**
- * @brief Counts material value of each player.
+ * @brief Blends the middlegame and endgame piece-square sums by the game phase.
  *
- * @param board The current state of the chessboard.
- * @return float The evaluation of the position.
- */
-float materialCount(const Board &board);
-
-/**
- * @brief Counts number of pieces each player has in the centre of the board,
- *
- * @param board The current state of the chessboard.
- * @return float The evaluation of the position.
+ * @param score The material, placement and game phase.
+ * @return Score The tapered score, positive if white is better.
  */
-float centrePresence(const Board &board);
+Score taperedScore(const PieceSquareScore &score);
 
 /**
- * @brief Counts number of pieces each player has attacking the centre of the board,
+ * @brief Run all heuristic functions to determine evaluation.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of the position.
- */
-float centreAttacks(const Board &board);
-
-/**
- * @brief Evaluates how developed each player's pieces are.
- *
- * @param board The current state odf the chessboard.
- * @return float The evaluation of the position.
+ * @param pawnTable The calling thread's cache of pawn structure evaluations.
+ * @return Score The evaluation of the position in centipawns, positive if white is better.
  */
-float development(const Board &board);
+Score evaluation(const Board &board, PawnTable &pawnTable);
 
 /**
- * @brief Run all heuristic functions to determine evaluation.
+ * @brief Evaluates the position without the incrementally updated scores, to check them.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of the position.
+ * @return Score The evaluation of the position in centipawns, positive if white is better.
  */
-float evaluation(const Board &board);
+Score evaluationFromScratch(const Board &board);
 
 /**
  * @brief Evaluate the safety of each player's king.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of king safety.
+ * @param pawns The evaluation of the board's pawn structure.
+ * @return Score The evaluation of king safety.
  */
-float kingSafety(const Board &board);
+Score kingSafety(const Board &board, PawnEntry &pawns);
 
 #endif
\ No newline at end of file
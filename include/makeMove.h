@@ -1,7 +1,7 @@
 /**
  * @file makeMove.h
  * @author Seán Rourke
- * @brief Defines makeMove function.
+ * @brief Defines makeMove and unmakeMove functions.
  * @date 2025
  *
  * @copyright Copyright (c) 2025
@@ -19,7 +19,34 @@
  *
  * @param board The current state of the chessboard.
  * @param move The selected move to be made.
+ * @return MoveHistory The state needed to unmake the move.
  */
-void makeMove(Board &board, const Move &move);
+MoveHistory makeMove(Board &board, const Move &move);
+
+/**
+ * @brief Restore the board to its state before a move was made.
+ *
+ * @param board The current state of the chessboard.
+ * @param history The history returned by makeMove for the move being unmade.
+ */
+void unmakeMove(Board &board, const MoveHistory &history);
+
+/**
+ * @brief Passes the turn to the opponent without moving a piece.
+ *
+ * Used by null-move pruning in the search; never a legal chess move.
+ *
+ * @param board The current state of the chessboard.
+ * @return MoveHistory The state needed to unmake the null move.
+ */
+MoveHistory makeNullMove(Board &board);
+
+/**
+ * @brief Restore the board to its state before a null move was made.
+ *
+ * @param board The current state of the chessboard.
+ * @param history The history returned by makeNullMove.
+ */
+void unmakeNullMove(Board &board, const MoveHistory &history);
 
 #endif
\ No newline at end of file
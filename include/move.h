@@ -12,21 +12,100 @@
 #define MOVE_H
 
 #include <iostream>
+#include <new>
 #include "board.h"
 
+/**
+ * @enum MoveFlag
+ * @brief Special move types stored in the top four bits of a move.
+ *
+ * Promotions set the PROMOTION bit, with the low two bits giving the promoted
+ * piece counted from KNIGHT.
+ */
+enum MoveFlag
+{
+    NORMAL_MOVE = 0, ///< Any move without special handling, including captures.
+    DOUBLE_PUSH = 1, ///< Pawn moving two squares forward.
+    CASTLING = 2,    ///< King castling (the king's from and to squares are stored).
+    EN_PASSANT = 3,  ///< Pawn capturing en passant.
+    PROMOTION = 8    ///< Pawn promotion, combined with the promoted piece.
+};
+
 /**
  * @struct Move
- * @brief Represents a chess move.
+ * @brief Represents a chess move packed into 16 bits.
  *
- * This structure stores the starting and ending squares of a move.
- * It also includes an optional promotion piece filed for pawn promotions.
+ * Bits 0-5 hold the starting square, bits 6-11 the ending square and bits
+ * 12-15 a MoveFlag. A move with all bits clear is the null move, used to mean
+ * "no move".
  */
 struct Move
 {
-    int from;                ///< The starting square of the move (0-63).
-    int to;                  ///< The ending square of the move (0-63).
-    int promotionPiece = -1; ///< The promoted piece type (if applicable, otherwise -1).
-    bool castling = false;
+    uint16_t data = 0; ///< The packed move.
+
+    /**
+     * @brief Construct the null move.
+     */
+    Move() = default;
+
+    /**
+     * @brief Construct a move from its squares and, optionally, a promotion piece or castling.
+     *
+     * @param from The starting square of the move (0-63).
+     * @param to The ending square of the move (0-63).
+     * @param promotionPiece The promoted piece type (if applicable, otherwise -1).
+     * @param castling Whether the move is the king's half of a castling move.
+     */
+    Move(int from, int to, int promotionPiece = -1, bool castling = false)
+        : data(static_cast<uint16_t>(from | (to << 6) |
+                                     (promotionPiece != -1 ? (PROMOTION | (promotionPiece - KNIGHT)) << 12
+                                                           : (castling ? CASTLING << 12 : 0))))
+    {
+    }
+
+    /**
+     * @brief Construct a move with a special move flag.
+     *
+     * @param from The starting square of the move (0-63).
+     * @param to The ending square of the move (0-63).
+     * @param flag The type of special move.
+     */
+    Move(int from, int to, MoveFlag flag)
+        : data(static_cast<uint16_t>(from | (to << 6) | (flag << 12)))
+    {
+    }
+
+    int from() const { return data & 63; }                    ///< The starting square of the move (0-63).
+    int to() const { return (data >> 6) & 63; }               ///< The ending square of the move (0-63).
+    int flag() const { return data >> 12; }                   ///< The MoveFlag bits of the move.
+    bool isNull() const { return data == 0; }                 ///< Whether this is the null move.
+    bool castling() const { return flag() == CASTLING; }      ///< Whether the move is castling.
+    bool enPassant() const { return flag() == EN_PASSANT; }   ///< Whether the move is an en passant capture.
+    bool doublePush() const { return flag() == DOUBLE_PUSH; } ///< Whether the move is a pawn double push.
+    bool isPromotion() const { return flag() & PROMOTION; }   ///< Whether the move is a promotion.
+
+    /**
+     * @brief Gets the piece a pawn promotes to.
+     *
+     * @return int The promoted piece type, or -1 if the move is not a promotion.
+     */
+    int promotionPiece() const { return isPromotion() ? KNIGHT + (flag() & 3) : -1; }
+
+    /**
+     * @brief Checks if two moves are identical.
+     *
+     * @param other The move to compare against.
+     * @return true If the moves are the same.
+     */
+    bool operator==(const Move &other) const { return data == other.data; }
+
+    /**
+     * @brief Checks if two moves differ.
+     *
+     * @param other The move to compare against.
+     * @return true If the moves are different.
+     */
+    bool operator!=(const Move &other) const { return data != other.data; }
 
     /**
      * @brief Overloads the << operator to print a move.
@@ -37,15 +116,71 @@ struct Move
     friend std::ostream &operator<<(std::ostream &os, const Move &move);
 };
 
+static_assert(sizeof(Move) == 2, "Move should pack into 16 bits");
+
+/**
+ * @class MoveList
+ * @brief A fixed-capacity list of moves stored inline.
+ *
+ * Move generators append into a MoveList owned by the caller, usually on the
+ * stack, so generating moves never allocates. The capacity comfortably exceeds
+ * the 218 legal moves possible in any position. The storage is raw bytes, so
+ * making a list writes nothing but the count; Move's null-move initialiser
+ * would otherwise clear all 256 slots at every node.
+ */
+class MoveList
+{
+public:
+    static const int CAPACITY = 256; ///< Maximum number of moves the list can hold.
+
+    /**
+     * @brief Appends a move to the end of the list.
+     *
+     * @param move The move to append.
+     */
+    void push_back(const Move &move) { new (data() + count++) Move(move); }
+
+    /**
+     * @brief Removes every move from the first removed position to the end.
+     *
+     * @param first The first move to remove.
+     */
+    void erase(const Move *first) { count = static_cast<int>(first - data()); }
+
+    void clear() { count = 0; }               ///< Removes every move.
+    int size() const { return count; }        ///< The number of moves in the list.
+    bool empty() const { return count == 0; } ///< Whether the list has no moves.
+
+    Move &operator[](int index) { return data()[index]; }             ///< Access a move by index.
+    const Move &operator[](int index) const { return data()[index]; } ///< Access a move by index.
+
+    Move *begin() { return data(); }                   ///< Iterator to the first move.
+    Move *end() { return data() + count; }             ///< Iterator past the last move.
+    const Move *begin() const { return data(); }       ///< Iterator to the first move.
+    const Move *end() const { return data() + count; } ///< Iterator past the last move.
+
+private:
+    Move *data() { return reinterpret_cast<Move *>(storage); }                   ///< The first slot.
+    const Move *data() const { return reinterpret_cast<const Move *>(storage); } ///< The first slot.
+
+    alignas(Move) unsigned char storage[CAPACITY * sizeof(Move)]; ///< Uninitialised inline storage for the moves.
+    int count = 0;                                                ///< Number of moves currently stored.
+};
+
+/**
+ * @struct MoveHistory
+ * @brief Stores the board state that a move overwrites, so it can be unmade.
+ */
 struct MoveHistory
 {
-    Move move;
-    Piece capturedPiece;
-    bool whiteCanCastleKingSide;
-    bool whiteCanCastleQueenSide;
-    bool blackCanCastleKingSide;
-    bool blackCanCastleQueenSide;
-    int enPassantSquare;
+    Move move;                               ///< The move that was made.
+    Piece capturedPiece;                     ///< The piece on the destination square before the move (EMPTY if none).
+    uint8_t castlingRights;                  ///< Castling rights before the move.
+    int8_t enPassantSquare;                  ///< En passant square before the move (-1 if none).
+    std::array<bool, MAX_COLOUR> hasCastled; ///< Whether each side had castled before the move.
+    uint64_t hashKey;                        ///< Zobrist key before the move.
+    uint64_t pawnKey;                        ///< Pawn-only Zobrist key before the move.
+    PieceSquareScore pieceSquareScore;       ///< Material and placement before the move.
 };
 
 #endif
@@ -13,7 +13,6 @@
 
 #include "board.h"
 #include "move.h"
-#include <vector>
 
 /**
  * @brief Generates all legal pawn moves from a given position.
@@ -22,9 +21,10 @@
  * @param file The file (column) of the pawn.
  * @param colour The colour of the pawn (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the pawn.
+ * @param targetMask The squares the pawn may move to without exposing its king.
+ * @param moves The list the pawn's moves are appended to.
  */
-std::vector<Move> generatePawnMoves(int rank, int file, Colour colour, const Board &board);
+void generatePawnMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves);
 
 /**
  * @brief Generates all legal knight moves from a given position.
@@ -33,9 +33,10 @@ std::vector<Move> generatePawnMoves(int rank, int file, Colour colour, const Boa
  * @param file The file (column) of the knight.
  * @param colour The colour of the knight (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the knight.
+ * @param targetMask The squares the knight may move to without exposing its king.
+ * @param moves The list the knight's moves are appended to.
  */
-std::vector<Move> generateKnightMoves(int rank, int file, Colour colour, const Board &board);
+void generateKnightMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves);
 
 /**
  * @brief Generates all legal bishop moves from a given position.
@@ -44,9 +45,10 @@ std::vector<Move> generateKnightMoves(int rank, int file, Colour colour, const B
  * @param file The file (column) of the bishop.
  * @param colour The colour of the bishop (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the bishop.
+ * @param targetMask The squares the bishop may move to without exposing its king.
+ * @param moves The list the bishop's moves are appended to.
  */
-std::vector<Move> generateBishopMoves(int rank, int file, Colour colour, const Board &board);
+void generateBishopMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves);
 
 /**
  * @brief Generates all legal rook moves from a given position.
@@ -55,9 +57,10 @@ std::vector<Move> generateBishopMoves(int rank, int file, Colour colour, const B
  * @param file The file (column) of the rook.
  * @param colour The colour of the rook (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the rook.
+ * @param targetMask The squares the rook may move to without exposing its king.
+ * @param moves The list the rook's moves are appended to.
  */
-std::vector<Move> generateRookMoves(int rank, int file, Colour colour, const Board &board);
+void generateRookMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves);
 
 /**
  * @brief Generates all legal queen moves from a given position.
@@ -66,9 +69,10 @@ std::vector<Move> generateRookMoves(int rank, int file, Colour colour, const Boa
  * @param file The file (column) of the queen.
  * @param colour The colour of the queen (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the queen.
+ * @param targetMask The squares the queen may move to without exposing its king.
+ * @param moves The list the queen's moves are appended to.
  */
-std::vector<Move> generateQueenMoves(int rank, int file, Colour colour, const Board &board);
+void generateQueenMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves);
 
 /**
  * @brief Generates all legal king moves from a given position.
@@ -77,17 +81,17 @@ std::vector<Move> generateQueenMoves(int rank, int file, Colour colour, const Bo
  * @param file The file (column) of the king.
  * @param colour The colour of the king (WHITE or BLACK).
  * @param board The current state of the chessboard.
- * @return std::vector<Move> A list of legal moves for the king.
+ * @param moves The list the king's moves are appended to.
  */
-std::vector<Move> generateKingMoves(int rank, int file, Colour colour, const Board &board);
+void generateKingMoves(int rank, int file, Colour colour, const Board &board, MoveList &moves);
 
 /**
  * @brief Generates all move for a player.
  *
- * @param board The current state of the board.
  * @param colour The colour of the player (WHITE or BLACK).
- * @return std::vector<Move>
+ * @param board The current state of the board.
+ * @param moves The list the player's legal moves are appended to.
  */
-std::vector<Move> generateMoves(Colour colour, const Board &board);
+void generateMoves(Colour colour, const Board &board, MoveList &moves);
 
 #endif
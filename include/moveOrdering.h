@@ -0,0 +1,101 @@
+/**
+ * @file moveOrdering.h
+ * @author Seán Rourke
+ * @brief Orders moves so the ones most likely to cause a cutoff are searched first.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef MOVE_ORDERING_H
+#define MOVE_ORDERING_H
+
+#include <array>
+#include "board.h"
+#include "move.h"
+
+const int MAX_PLY = 128; ///< Deepest ply from the root the search keeps per-ply data for.
+
+/**
+ * @struct SearchHeuristics
+ * @brief Move ordering data learned during a search: killer moves and butterfly history.
+ */
+struct SearchHeuristics
+{
+    static const int HISTORY_MAX = 1 << 16; ///< History scores are halved when one passes this.
+
+    std::array<std::array<Move, 2>, MAX_PLY> killers = {};                      ///< Two quiet cutoff moves per ply.
+    std::array<std::array<std::array<int, 64>, 64>, MAX_COLOUR> history = {}; ///< Cutoff score per [colour][from][to].
+
+    /**
+     * @brief Forgets all killer moves and history scores.
+     */
+    void clear();
+
+    /**
+     * @brief Records a quiet move that caused a beta cutoff.
+     *
+     * The move becomes the first killer for its ply and its history score
+     * grows by the square of the remaining depth.
+     *
+     * @param colour The side that made the move.
+     * @param move The move that caused the cutoff.
+     * @param ply The distance from the root.
+     * @param depth The remaining depth of the search that cut off.
+     */
+    void updateQuietCutoff(Colour colour, const Move &move, int ply, int depth);
+};
+
+/**
+ * @class MovePicker
+ * @brief Scores a node's moves once and hands them out best first.
+ *
+ * The transposition table move comes first, then captures by most valuable
+ * victim and least valuable attacker (MVV-LVA) with queen promotions, then
+ * the killer moves, then the remaining quiet moves by history score, then
+ * captures that lose material by static exchange, and finally underpromotions.
+ */
+class MovePicker
+{
+public:
+    /**
+     * @brief Construct a new Move Picker object.
+     *
+     * @param board The current state of the chessboard.
+     * @param moves The legal moves to order. Reordered in place as moves are picked.
+     * @param ttMove The best move stored in the transposition table (the null move if none).
+     * @param heuristics The killer moves and history scores of the current search.
+     * @param ply The distance from the root.
+     */
+    MovePicker(const Board &board, MoveList &moves, const Move &ttMove, const SearchHeuristics &heuristics, int ply);
+
+    /**
+     * @brief Gives the best move not yet picked.
+     *
+     * @param move Set to the next move.
+     * @return true If a move was picked.
+     * @return false If every move has been picked.
+     */
+    bool next(Move &move);
+
+private:
+    MoveList &moves;                              ///< The moves being ordered.
+    std::array<int, MoveList::CAPACITY> scores;   ///< Ordering score of each move.
+    int picked = 0;                               ///< Number of moves already handed out.
+};
+
+/**
+ * @brief Checks whether a move captures a piece.
+ *
+ * @param board The current state of the chessboard.
+ * @param move The move to check.
+ * @return true If the move is a capture (including en passant).
+ * @return false If the move does not capture.
+ */
+inline bool isCapture(const Board &board, const Move &move)
+{
+    return board.pieceOn(move.to()) != EMPTY || move.enPassant();
+}
+
+#endif
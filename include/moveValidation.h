@@ -11,12 +11,10 @@
 #ifndef MOVEVALIDATION_H
 #define MOVEVALIDATION_H
 
-#include <algorithm>
 #include "board.h"
-#include "move.h"
 
 /**
- * @brief
+ * @brief Checks if a square is attacked by any piece of the given colour.
  *
  * @param square The square being checked for attacks.
  * @param attacker The colour of the attacking player.
@@ -27,12 +25,33 @@
 bool isSquareAttacked(int square, Colour attacker, const Board &board);
 
 /**
- * @brief Filters out moves that would leave the moving player's king in check.
+ * @brief Checks if a player's king is in check.
  *
- * @param moves Unfiltered generated moves.
  * @param board The current state of the chessboard.
- * @param colour The player making the move.
+ * @param colour The player whose king is checked.
+ * @return true If the king is attacked.
+ * @return false If the king is safe.
  */
-void filterIllegalMoves(std::vector<Move> &moves, const Board &board, Colour colour);
+bool isInCheck(const Board &board, Colour colour);
+
+/**
+ * @brief Finds the pieces of a player that are pinned to their own king.
+ *
+ * @param board The current state of the chessboard.
+ * @param colour The player whose pinned pieces are found.
+ * @return Bitboard The squares of the pinned pieces.
+ */
+Bitboard pinnedPieces(const Board &board, Colour colour);
+
+/**
+ * @brief Checks if an en passant capture leaves the moving player's king safe.
+ *
+ * @param board The current state of the chessboard.
+ * @param from The square of the capturing pawn.
+ * @param colour The player making the capture.
+ * @return true If the capture is legal.
+ * @return false If the capture would leave the king in check.
+ */
+bool isEnPassantLegal(const Board &board, int from, Colour colour);
 
 #endif
\ No newline at end of file
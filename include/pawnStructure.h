@@ -0,0 +1,88 @@
+/**
+ * @file pawnStructure.h
+ * @author Seán Rourke
+ * @brief Evaluates the pawn structure and caches it by the pawn-only hash key.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef PAWN_STRUCTURE_H
+#define PAWN_STRUCTURE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include "board.h"
+#include "score.h"
+
+/**
+ * @struct PawnEntry
+ * @brief The evaluation of one pawn structure.
+ *
+ * Scores are from white's point of view. The shield of each king depends on
+ * the king's square as well, so it is remembered for the last square it was
+ * worked out for.
+ */
+struct PawnEntry
+{
+    uint64_t key = 0;                                           ///< Pawn key of the structure (0 with no pawns).
+    int16_t middlegame = 0;                                     ///< Doubled, isolated, backward and passed pawn terms in the middlegame.
+    int16_t endgame = 0;                                        ///< The same terms in the endgame.
+    std::array<int8_t, MAX_COLOUR> shieldKingSquare = {-1, -1}; ///< King square each shield score is for (-1 if none).
+    std::array<int16_t, MAX_COLOUR> shieldScore = {};           ///< Bonus for the pawns sheltering each king.
+
+    /**
+     * @brief Gives the bonus for the pawns in front of a king on its back rank.
+     *
+     * @param board The current state of the chessboard, with this entry's pawns.
+     * @param colour The side whose king is sheltered.
+     * @return Score The shield bonus for that side (never negative).
+     */
+    Score shield(const Board &board, Colour colour);
+};
+
+/**
+ * @brief Evaluates a pawn structure from scratch.
+ *
+ * @param board The current state of the chessboard.
+ * @param entry Filled in with the pawn key and scores. The shield is reset.
+ */
+void evaluatePawns(const Board &board, PawnEntry &entry);
+
+/**
+ * @class PawnTable
+ * @brief Per-thread cache of pawn structure evaluations, indexed by the pawn key.
+ *
+ * Pawns move rarely, so almost every probe hits. Each search thread owns its
+ * table, so entries are read and written without synchronisation.
+ */
+class PawnTable
+{
+public:
+    static const int SIZE = 1 << 13; ///< Number of entries (a power of two).
+
+    /**
+     * @brief Construct a new Pawn Table object with every entry empty.
+     */
+    PawnTable();
+
+    /**
+     * @brief Finds the entry for the board's pawn structure, evaluating it on a miss.
+     *
+     * @param board The current state of the chessboard.
+     * @return PawnEntry& The entry, valid until the next probe.
+     */
+    PawnEntry &probe(const Board &board);
+
+    /**
+     * @brief Empties every entry, for a new game.
+     */
+    void clear();
+
+private:
+    std::unique_ptr<PawnEntry[]> entries; ///< The table storage.
+};
+
+#endif
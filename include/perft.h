@@ -0,0 +1,110 @@
+/**
+ * @file perft.h
+ * @author Seán Rourke
+ * @brief Counts move generation tree nodes to verify and time the move generator.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef PERFT_H
+#define PERFT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include "board.h"
+
+/**
+ * @class PerftTable
+ * @brief Fixed-size cache of subtree leaf counts keyed by position and depth.
+ *
+ * Shared by all perft threads without locks. Each slot stores its key XORed
+ * with its data, so a slot torn by a concurrent store fails verification and
+ * is treated as a miss rather than returning a wrong count.
+ */
+class PerftTable
+{
+public:
+    /**
+     * @brief Construct a new Perft Table object.
+     *
+     * @param megabytes The size of the table in megabytes.
+     */
+    explicit PerftTable(std::size_t megabytes);
+
+    /**
+     * @brief Looks up the leaf count of a position at a depth.
+     *
+     * @param key The Zobrist key of the position.
+     * @param depth The remaining depth.
+     * @param nodes Set to the stored leaf count if found.
+     * @return true If the count was found.
+     * @return false If the count was not found.
+     */
+    bool probe(uint64_t key, int depth, uint64_t &nodes) const;
+
+    /**
+     * @brief Stores the leaf count of a position at a depth.
+     *
+     * @param key The Zobrist key of the position.
+     * @param depth The remaining depth.
+     * @param nodes The leaf count.
+     */
+    void store(uint64_t key, int depth, uint64_t nodes);
+
+private:
+    /**
+     * @struct Slot
+     * @brief A single stored count: the key XORed with the packed data, and the data.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> keyXorData{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    std::unique_ptr<Slot[]> slots; ///< The table storage.
+    std::size_t slotMask = 0;      ///< Number of slots minus one (always a power of two).
+};
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree to a given depth.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param depth The number of plies to count to.
+ * @return uint64_t The number of leaf nodes.
+ */
+uint64_t perft(Board &board, int depth);
+
+/**
+ * @brief Counts leaf nodes like perft, printing the count below each root move.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param depth The number of plies to count to.
+ * @param out The stream each "move: count" line is written to.
+ * @return uint64_t The total number of leaf nodes.
+ */
+uint64_t perftDivide(Board &board, int depth, std::ostream &out);
+
+/**
+ * @brief Counts leaf nodes like perft, splitting the work across several threads.
+ *
+ * Every position splitDepth plies below the root becomes a work item, and the
+ * threads take items from a shared queue until none are left. If a table is
+ * given, subtree counts are cached in it so transposed subtrees are counted
+ * once.
+ *
+ * @param board The position to count from.
+ * @param depth The number of plies to count to.
+ * @param threads The number of worker threads.
+ * @param splitDepth The number of plies expanded before handing work to threads.
+ * @param table Optional shared cache of subtree counts (nullptr for none).
+ * @return uint64_t The number of leaf nodes.
+ */
+uint64_t parallelPerft(const Board &board, int depth, int threads, int splitDepth = 1, PerftTable *table = nullptr);
+
+#endif
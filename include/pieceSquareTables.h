@@ -0,0 +1,64 @@
+/**
+ * @file pieceSquareTables.h
+ * @author Seán Rourke
+ * @brief Defines the tapered material and piece-square tables used by the evaluation.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef PIECE_SQUARE_TABLES_H
+#define PIECE_SQUARE_TABLES_H
+
+#include "board.h"
+
+const int MAX_PHASE = 24; ///< Game phase with all the non-pawn material on the board.
+
+constexpr int phaseWeights[MAX_PIECE_TYPE] = {0, 1, 1, 2, 4, 0}; ///< Contribution of each piece to the game phase.
+
+/**
+ * @struct PieceSquareTables
+ * @brief Value of each piece on each square, material included, for both game phases.
+ *
+ * Values are from white's point of view, so black's entries are negative.
+ */
+struct PieceSquareTables
+{
+    int16_t middlegame[MAX_COLOUR][MAX_PIECE_TYPE][64]; ///< Values while most pieces are on the board.
+    int16_t endgame[MAX_COLOUR][MAX_PIECE_TYPE][64];    ///< Values once the pieces have been traded off.
+};
+
+extern const PieceSquareTables pieceSquareTables; ///< The tables, generated at compile time.
+
+/**
+ * @brief Adds a piece standing on a square to a running score.
+ *
+ * @param score The score to update.
+ * @param colour The colour of the piece.
+ * @param piece The piece type.
+ * @param square The square the piece stands on.
+ */
+inline void addPieceSquare(PieceSquareScore &score, Colour colour, Piece piece, int square)
+{
+    score.middlegame += pieceSquareTables.middlegame[colour][piece][square];
+    score.endgame += pieceSquareTables.endgame[colour][piece][square];
+    score.phase += phaseWeights[piece];
+}
+
+/**
+ * @brief Removes a piece leaving a square from a running score.
+ *
+ * @param score The score to update.
+ * @param colour The colour of the piece.
+ * @param piece The piece type.
+ * @param square The square the piece leaves.
+ */
+inline void removePieceSquare(PieceSquareScore &score, Colour colour, Piece piece, int square)
+{
+    score.middlegame -= pieceSquareTables.middlegame[colour][piece][square];
+    score.endgame -= pieceSquareTables.endgame[colour][piece][square];
+    score.phase -= phaseWeights[piece];
+}
+
+#endif
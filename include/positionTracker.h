@@ -0,0 +1,51 @@
+/**
+ * @file positionTracker.h
+ * @author Seán Rourke
+ * @brief Keeps the board in step with the UCI "position" commands sent by the GUI.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef POSITION_TRACKER_H
+#define POSITION_TRACKER_H
+
+#include <string>
+#include <string_view>
+#include "board.h"
+
+/**
+ * @class PositionTracker
+ * @brief Applies "position startpos|fen <FEN> [moves ...]" commands to a board.
+ *
+ * GUIs resend the whole game with every command. The tracker remembers the
+ * starting position and the moves already on the board, so when a command only
+ * extends them just the new moves are played. Any other command rebuilds the
+ * board from its starting position.
+ */
+class PositionTracker
+{
+public:
+    /**
+     * @brief Brings the board to the position described by a UCI position command.
+     *
+     * @param board The board to update.
+     * @param command The full command, starting with "position".
+     * @throws std::invalid_argument If the command, FEN or a move is invalid. The
+     * board and the tracked position are then left as they were.
+     */
+    void update(Board &board, std::string_view command);
+
+    /**
+     * @brief Forgets the tracked position so the next command rebuilds the board.
+     */
+    void reset();
+
+private:
+    std::string fen;          ///< Starting position of the moves on the board.
+    std::string appliedMoves; ///< Move list text already played on the board.
+    bool synced = false;      ///< Whether the board matches fen and appliedMoves.
+};
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file score.h
+ * @author Seán Rourke
+ * @brief Defines the integer centipawn score used by the evaluation and the search.
+ * @date 2025
+ *
+ * Scores are whole centipawns. Mates are encoded by their distance from the
+ * root: being mated at ply n scores -(SCORE_MATE - n), so the search prefers
+ * the quickest mate and the slowest loss. Every score fits in 16 bits.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SCORE_H
+#define SCORE_H
+
+#include <cstdint>
+
+using Score = int32_t; ///< A score in centipawns, positive if the side it is for is better.
+
+constexpr Score SCORE_DRAW = 0;                       ///< The score of a drawn position.
+constexpr Score SCORE_MATE = 32000;                   ///< The score for delivering mate at the root.
+constexpr Score SCORE_INFINITE = 32001;               ///< Larger than any score; used for open windows.
+constexpr Score SCORE_MATE_BOUND = SCORE_MATE - 1000; ///< Scores beyond this in size are mate scores.
+
+/**
+ * @brief Gives the score for delivering mate a number of plies from the root.
+ *
+ * @param ply The distance from the root of the mated position.
+ * @return Score The mate score.
+ */
+constexpr Score mateIn(int ply)
+{
+    return SCORE_MATE - ply;
+}
+
+/**
+ * @brief Gives the score for being mated a number of plies from the root.
+ *
+ * @param ply The distance from the root of the mated position.
+ * @return Score The mated score.
+ */
+constexpr Score matedIn(int ply)
+{
+    return -SCORE_MATE + ply;
+}
+
+/**
+ * @brief Checks whether a score is a forced mate for either side.
+ *
+ * @param score The score to check.
+ * @return true If the score encodes a mate distance.
+ */
+constexpr bool isMateScore(Score score)
+{
+    return score >= SCORE_MATE_BOUND || score <= -SCORE_MATE_BOUND;
+}
+
+/**
+ * @brief Converts a mate score from distance-to-root to distance-to-node before it is stored.
+ *
+ * A hashed position can be reached again at another ply, so mates are stored
+ * relative to the position itself.
+ *
+ * @param score The score found at the node.
+ * @param ply The distance of the node from the root.
+ * @return Score The score to store in the transposition table.
+ */
+constexpr Score scoreToTT(Score score, int ply)
+{
+    return (score >= SCORE_MATE_BOUND) ? score + ply : (score <= -SCORE_MATE_BOUND) ? score - ply : score;
+}
+
+/**
+ * @brief Converts a stored mate score back to distance-to-root.
+ *
+ * @param score The score read from the transposition table.
+ * @param ply The distance of the node from the root.
+ * @return Score The score relative to the root.
+ */
+constexpr Score scoreFromTT(Score score, int ply)
+{
+    return (score >= SCORE_MATE_BOUND) ? score - ply : (score <= -SCORE_MATE_BOUND) ? score + ply : score;
+}
+
+#endif
@@ -8,22 +8,148 @@
  *
  */
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include "board.h"
 #include "makeMove.h"
+#include "moveOrdering.h"
+#include "pawnStructure.h"
+#include "score.h"
+#include "timeManager.h"
+#include "workStealing.h"
 
 #ifndef SEARCH_H
 #define SEARCH_H
 
 /**
- * @brief Performs the Alpha-Beta pruning search algorithm to find the best move evaluation.
+ * @struct SearchParameters
+ * @brief Tunable search settings, settable through UCI options. Margins are in centipawns.
+ */
+struct SearchParameters
+{
+    static const int MAX_PRUNING_DEPTH = 3; ///< Deepest remaining depth the frontier pruning applies at.
+    static constexpr int MAX_THREADS = 256; ///< Most threads a search may use.
+
+    int threads = 1;           ///< Number of threads searching each move.
+    bool workStealing = false; ///< Split nodes between the threads (YBWC) instead of running lazy SMP.
+    int splitDepth = 4;        ///< Shallowest remaining depth a node is split at when work stealing.
+
+    int futilityMargin = 100;        ///< Per ply: quiet moves are skipped if the evaluation plus this cannot reach alpha.
+    int reverseFutilityMargin = 80;  ///< Per ply: the node fails high if the evaluation minus this still beats beta.
+    int razorMargin = 300;           ///< Per ply: the node drops into quiescence if the evaluation plus this is below alpha.
+};
+
+extern SearchParameters searchParameters; ///< The settings used by every search.
+
+/**
+ * @struct SearchSignals
+ * @brief Flags that another thread uses to control a running search.
+ */
+struct SearchSignals
+{
+    std::atomic<bool> stop{false};   ///< Raised to end the search early; the search also raises it to stop its helpers.
+    std::atomic<bool> ponder{false}; ///< Set while pondering; cleared on ponderhit to start the clock.
+};
+
+/**
+ * @struct SearchResult
+ * @brief The move to play and the reply the engine expects.
+ */
+struct SearchResult
+{
+    Move bestMove;   ///< The move to play (the null move if there are no legal moves).
+    Move ponderMove; ///< The expected reply to ponder on (the null move if none is known).
+};
+
+/**
+ * @struct SearchContext
+ * @brief State shared by every node one thread searches.
  *
- * @param board The current state of the chessboard.
+ * Each thread has its own context, so move ordering and the principal
+ * variation are never shared. Only the stop signal, the transposition table
+ * and, when work stealing, the split points are shared between threads.
+ */
+struct SearchContext
+{
+    static const uint64_t NODES_BETWEEN_TIME_CHECKS = 2048; ///< How often the clock is read (a power of two).
+
+    TimeManager time;                        ///< The budget for this move (read by the main thread only).
+    std::atomic<uint64_t> nodes{0};          ///< Nodes visited so far, written only by the owning thread.
+    bool stopped = false;                    ///< Set once the stop signal is seen; the search then unwinds.
+    SearchSignals *signals = nullptr;        ///< Stop and ponder flags shared by every thread of the search.
+    bool pondering = false;                  ///< Whether the main thread is still ignoring the clock.
+    int threadIndex = 0;                     ///< 0 for the main thread, which reads the clock and reports.
+    WorkStealingPool *pool = nullptr;        ///< The pool to split nodes into, or nullptr to search alone.
+    SplitPoint *splitPoint = nullptr;        ///< The innermost split node this thread is helping with.
+    SearchHeuristics heuristics;             ///< Killer moves and history scores for move ordering.
+    PawnTable pawnTable;                     ///< Pawn structure evaluations cached by this thread.
+
+    int completedDepth = 0; ///< Deepest iteration this thread finished.
+    Move bestMove;          ///< Best move of that iteration.
+    Move ponderMove;        ///< Expected reply in that iteration's principal variation.
+    Score bestScore = 0;    ///< Score of that iteration.
+
+    /**
+     * @brief Triangular principal variation table.
+     * pvTable[ply] holds the best line found from that ply, pvLength[ply] moves long.
+     */
+    std::array<std::array<Move, MAX_PLY>, MAX_PLY> pvTable;
+    std::array<int, MAX_PLY> pvLength = {}; ///< Length of the line stored for each ply.
+};
+
+/**
+ * @brief Searches only captures and promotions until the position is quiet.
+ *
+ * @param context The state of the current search.
+ * @param board The current state of the chessboard, restored before returning.
+ * @param ply The distance from the root.
+ * @param alpha The score the side to move is already guaranteed.
+ * @param beta The score the opponent will not allow the side to move to exceed.
+ * @return Score The score for the side to move (meaningless if the search was stopped).
+ */
+Score quiescence(SearchContext &context, Board &board, int ply, Score alpha, Score beta);
+
+/**
+ * @brief Searches a position with negamax principal variation search.
+ *
+ * @param context The state of the current search.
+ * @param board The current state of the chessboard, restored before returning.
  * @param depth How deep to look down the tree.
- * @param alpha The best score the maximising player can guarantee.
- * @param beta The best score the minimising player can guarentee.
- * @param maximisingPlayer Whether the current player is the maximising or minimising player.
- * @return float The best evaluation score found.
+ * @param ply The distance from the root.
+ * @param alpha The score the side to move is already guaranteed.
+ * @param beta The score the opponent will not allow the side to move to exceed.
+ * @param allowNullMove Whether null-move pruning may be tried (false straight after a null move).
+ * @return Score The score for the side to move (meaningless if the search was stopped).
+ */
+Score alphaBeta(SearchContext &context, Board &board, int depth, int ply, Score alpha, Score beta, bool allowNullMove = true);
+
+/**
+ * @brief Builds the late move reduction table. Must be called once at startup before searching.
+ */
+void initialiseSearch();
+
+/**
+ * @brief Empties every search thread's pawn table, for a new game.
+ *
+ * The search contexts are kept between searches, so their pawn tables carry
+ * over from move to move. Must not be called while a search is running.
+ */
+void clearPawnTables();
+
+/**
+ * @brief Searches for the best move with iterative deepening within the given limits.
+ *
+ * Prints a UCI info line, including the principal variation, after each
+ * completed iteration. With more than one thread the searchParameters
+ * choose between lazy SMP and work stealing.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param limits The time and depth limits from the go command.
+ * @param signals Lets another thread stop the search or end pondering. The stop
+ * flag is also raised once the search has finished, to stop the helpers.
+ * @return SearchResult The best move found and the reply to ponder on.
  */
-float alphaBeta(Board board, int depth, float alpha, float beta, bool maximisingPlayer);
+SearchResult findBestMove(Board &board, const SearchLimits &limits, SearchSignals &signals);
 
-#endif
\ No newline at end of file
+#endif
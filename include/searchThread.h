@@ -0,0 +1,88 @@
+/**
+ * @file searchThread.h
+ * @author Seán Rourke
+ * @brief Runs searches on a background thread so the UCI loop stays responsive.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SEARCH_THREAD_H
+#define SEARCH_THREAD_H
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "board.h"
+#include "search.h"
+#include "timeManager.h"
+
+/**
+ * @class SearchThread
+ * @brief A persistent thread that searches one position at a time and reports the best move.
+ *
+ * The UCI loop hands over a copy of the board and returns at once. The search
+ * polls an atomic stop flag, so "stop" ends it within a few nodes and the move
+ * of the last completed iteration is reported straight away. An infinite
+ * search holds back its bestmove until it is told to stop, and a ponder
+ * search until ponderhit or stop, as UCI requires.
+ */
+class SearchThread
+{
+public:
+    /**
+     * @brief Starts the thread, which waits for a search.
+     */
+    SearchThread();
+
+    /**
+     * @brief Stops any search and joins the thread.
+     */
+    ~SearchThread();
+
+    SearchThread(const SearchThread &) = delete;
+    SearchThread &operator=(const SearchThread &) = delete;
+
+    /**
+     * @brief Starts searching a position, waiting first for any previous search to finish.
+     *
+     * @param board The position to search, which is copied.
+     * @param limits The time and depth limits from the go command.
+     */
+    void go(const Board &board, const SearchLimits &limits);
+
+    /**
+     * @brief Tells the current search to stop and report its best move. Does not wait.
+     */
+    void stop();
+
+    /**
+     * @brief Turns the current ponder search into a normal timed search. Does not wait.
+     */
+    void ponderHit();
+
+    /**
+     * @brief Blocks until no search is running.
+     */
+    void wait();
+
+private:
+    std::thread thread;                  ///< The thread the searches run on.
+    std::mutex mutex;                    ///< Guards the fields below except signals.
+    std::condition_variable condition;   ///< Signals a new search, a stop request or a finished search.
+    bool searching = false;              ///< Whether a search has been handed over and not yet reported.
+    bool stopRequested = false;          ///< Whether "stop" was received for the current search.
+    bool pondering = false;              ///< Whether the current search is a ponder search awaiting ponderhit.
+    bool quitting = false;               ///< Set by the destructor to end the thread.
+    Board board;                         ///< The position being searched.
+    SearchLimits limits;                 ///< The limits of the search.
+    SearchSignals signals;               ///< Polled by the search threads.
+
+    /**
+     * @brief Waits for searches and runs them until the object is destroyed.
+     */
+    void loop();
+};
+
+#endif
@@ -0,0 +1,36 @@
+/**
+ * @file see.h
+ * @author Seán Rourke
+ * @brief Static exchange evaluation: the material result of a sequence of captures on one square.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SEE_H
+#define SEE_H
+
+#include "board.h"
+#include "move.h"
+
+/**
+ * @brief Piece values in centipawns used by the static exchange evaluation.
+ */
+constexpr int seePieceValues[MAX_PIECE_TYPE] = {100, 300, 300, 500, 900, 20000};
+
+/**
+ * @brief Works out the material won or lost by a move if both sides keep
+ * recapturing on its destination square with their least valuable attacker.
+ *
+ * Either side may stop recapturing when continuing would lose material.
+ * Pins are ignored, but pieces behind an attacker on the same line (x-rays)
+ * join in once the attacker in front has captured.
+ *
+ * @param board The current state of the chessboard.
+ * @param move The move to evaluate.
+ * @return int The expected material gain for the side making the move, in centipawns.
+ */
+int staticExchange(const Board &board, const Move &move);
+
+#endif
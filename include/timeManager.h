@@ -0,0 +1,94 @@
+/**
+ * @file timeManager.h
+ * @author Seán Rourke
+ * @brief Decides how long to search each move from the UCI clock information.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+
+#include <chrono>
+#include <cstdint>
+#include "board.h"
+
+const int MAX_SEARCH_DEPTH = 64; ///< Deepest iteration the search will start.
+
+/**
+ * @struct SearchLimits
+ * @brief The limits given by a UCI "go" command. Times are in milliseconds, -1 if not given.
+ */
+struct SearchLimits
+{
+    int64_t whiteTime = -1;         ///< White's remaining clock time (wtime).
+    int64_t blackTime = -1;         ///< Black's remaining clock time (btime).
+    int64_t whiteIncrement = 0;     ///< White's increment per move (winc).
+    int64_t blackIncrement = 0;     ///< Black's increment per move (binc).
+    int movesToGo = 0;              ///< Moves until the next time control, 0 if sudden death (movestogo).
+    int64_t moveTime = -1;          ///< Exact time to spend on this move (movetime).
+    int depth = MAX_SEARCH_DEPTH;   ///< Deepest iteration to search (depth).
+    bool infinite = false;          ///< Search until told to stop (infinite).
+    bool ponder = false;            ///< Search during the opponent's time until ponderhit or stop (ponder).
+};
+
+/**
+ * @class TimeManager
+ * @brief Tracks the time spent on a move against a soft and a hard budget.
+ *
+ * The soft budget is checked between iterations: once it has passed, a new
+ * iteration is not worth starting. The hard budget is checked during the
+ * search, which is aborted as soon as it passes.
+ */
+class TimeManager
+{
+public:
+    static const int64_t MOVE_OVERHEAD_MS = 30; ///< Time kept back for communication delays.
+
+    /**
+     * @brief Starts the clock and works out the budgets for a move.
+     *
+     * @param limits The limits from the go command.
+     * @param colour The side the engine is moving for.
+     */
+    void start(const SearchLimits &limits, Colour colour);
+
+    /**
+     * @brief Gives the time since the search started.
+     *
+     * @return int64_t The elapsed time in milliseconds.
+     */
+    int64_t elapsed() const;
+
+    /**
+     * @brief Checks whether there is time left to start another iteration.
+     *
+     * @return true If the soft budget has been used up.
+     * @return false If there is time for another iteration.
+     */
+    bool softLimitReached() const;
+
+    /**
+     * @brief Checks whether the search must stop immediately.
+     *
+     * @return true If the hard budget has been used up.
+     * @return false If the search may continue.
+     */
+    bool hardLimitReached() const;
+
+    /**
+     * @brief Starts the budgets from now, once a ponder search has become a normal search.
+     *
+     * The elapsed time keeps counting from the start of the ponder search.
+     */
+    void ponderHit();
+
+private:
+    std::chrono::steady_clock::time_point startTime; ///< When the search started.
+    int64_t softLimit = -1;                          ///< Soft budget in milliseconds (-1 if unlimited).
+    int64_t hardLimit = -1;                          ///< Hard budget in milliseconds (-1 if unlimited).
+};
+
+#endif
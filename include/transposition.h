@@ -0,0 +1,141 @@
+/**
+ * @file transposition.h
+ * @author Seán Rourke
+ * @brief Defines the transposition table used to cache search results by position.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef TRANSPOSITION_H
+#define TRANSPOSITION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "move.h"
+#include "score.h"
+
+/**
+ * @enum Bound
+ * @brief Describes how a stored score relates to the true value of the position.
+ */
+enum Bound
+{
+    BOUND_NONE,  ///< No score stored.
+    BOUND_EXACT, ///< The score is the exact value.
+    BOUND_LOWER, ///< The true value is at least the score (the search failed high).
+    BOUND_UPPER  ///< The true value is at most the score (the search failed low).
+};
+
+/**
+ * @struct TTEntry
+ * @brief A decoded transposition table entry returned by a probe.
+ */
+struct TTEntry
+{
+    Move move;   ///< Best move found in the position (the null move if none).
+    Score score; ///< The stored score.
+    int depth;   ///< Depth the position was searched to.
+    Bound bound; ///< How the score bounds the true value.
+};
+
+/**
+ * @class TranspositionTable
+ * @brief Fixed-size hash table of search results, shared safely between threads.
+ *
+ * Entries are grouped into cache-line sized buckets. Each entry stores its key
+ * XORed with its data, so a write torn by another thread fails verification on
+ * probe instead of returning another position's data. No locks are taken.
+ */
+class TranspositionTable
+{
+public:
+    static const int DEFAULT_SIZE_MB = 16; ///< Table size used until a Hash option is received.
+    static const int MAX_SIZE_MB = 4096;   ///< Largest table size the Hash option accepts.
+
+    /**
+     * @brief Construct a new Transposition Table object.
+     *
+     * @param megabytes The size of the table in megabytes.
+     */
+    explicit TranspositionTable(std::size_t megabytes = DEFAULT_SIZE_MB);
+
+    /**
+     * @brief Reallocates the table to a new size, discarding all entries.
+     *
+     * @param megabytes The size of the table in megabytes.
+     */
+    void resize(std::size_t megabytes);
+
+    /**
+     * @brief Removes all entries from the table.
+     */
+    void clear();
+
+    /**
+     * @brief Marks the start of a new search so older entries are replaced first.
+     */
+    void newSearch();
+
+    /**
+     * @brief Looks up a position in the table.
+     *
+     * @param key The Zobrist key of the position.
+     * @param entry Filled in with the stored data if the position is found.
+     * @return true If the position was found.
+     * @return false If the position was not found.
+     */
+    bool probe(uint64_t key, TTEntry &entry) const;
+
+    /**
+     * @brief Stores a search result in the table.
+     *
+     * @param key The Zobrist key of the position.
+     * @param depth The depth the position was searched to.
+     * @param score The score found.
+     * @param bound How the score bounds the true value.
+     * @param move The best move found (the null move if none).
+     */
+    void store(uint64_t key, int depth, Score score, Bound bound, const Move &move);
+
+private:
+    /**
+     * @struct Slot
+     * @brief A single stored entry: the key XORed with the packed data, and the data.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> keyXorData{0};
+        std::atomic<uint64_t> data{0};
+    };
+
+    static const int BUCKET_SIZE = 4; ///< Entries per bucket (4 x 16 bytes = one cache line).
+
+    /**
+     * @struct Bucket
+     * @brief A cache line of slots that a key can be stored in.
+     */
+    struct alignas(64) Bucket
+    {
+        Slot slots[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> buckets; ///< The table storage.
+    std::size_t bucketMask = 0;        ///< Number of buckets minus one (always a power of two).
+    uint8_t generation = 0;            ///< Age of the current search, stored in each entry.
+
+    /**
+     * @brief Finds the bucket a key belongs to.
+     *
+     * @param key The Zobrist key of the position.
+     * @return Bucket& The bucket for the key.
+     */
+    Bucket &bucketFor(uint64_t key) const { return buckets[key & bucketMask]; }
+};
+
+extern TranspositionTable transpositionTable; ///< The table shared by all searches.
+
+#endif
@@ -13,13 +13,14 @@
 
 #include "move.h"
 #include <string>
+#include <string_view>
 
 /**
  * @brief Converts a move to UCI notation.
  *
  * @param move The move who's squares are being converted.
  */
-std::string convertToUCI(Move &move);
+std::string convertToUCI(const Move &move);
 
 /**
  * @brief Converts a move from UCI notation to numerical representation.
@@ -27,6 +28,6 @@ std::string convertToUCI(Move &move);
  * @param board The current state of the chessboard.
  * @param moveString The move who's squares are being converted.
  */
-Move convertFromUCI(Board &board, std::string &moveString);
+Move convertFromUCI(const Board &board, std::string_view moveString);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+ * @file workStealing.h
+ * @author Seán Rourke
+ * @brief Defines the thread pool that shares the moves of split search nodes.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef WORK_STEALING_H
+#define WORK_STEALING_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "move.h"
+
+struct SplitPoint;
+
+/**
+ * @struct SplitTask
+ * @brief One move of a split node, waiting to be searched by any thread.
+ */
+struct SplitTask
+{
+    SplitPoint *splitPoint = nullptr; ///< The node the move is played from.
+    Move move;                        ///< The move to search.
+    int moveNumber = 0;               ///< Position of the move in the node's ordering.
+};
+
+/**
+ * @class WorkStealingPool
+ * @brief Worker threads that take split tasks from each other's deques.
+ *
+ * Every worker has its own deque. A worker pushes the tasks of the nodes it
+ * splits onto the back of its own deque and takes them back from the back,
+ * newest first. Idle workers steal from the front of other deques, where the
+ * oldest and so largest tasks are. Worker 0 is the thread that started the
+ * pool; it only runs tasks while waiting for its own splits to finish.
+ */
+class WorkStealingPool
+{
+public:
+    /// Searches one task on the given worker.
+    using TaskRunner = std::function<void(int worker, const SplitTask &task)>;
+
+    ~WorkStealingPool();
+
+    /**
+     * @brief Creates the deques and starts the helper threads.
+     *
+     * @param workers The number of workers, including the calling thread.
+     * @param runner Called by a helper thread for every task it steals.
+     */
+    void start(int workers, TaskRunner runner);
+
+    /**
+     * @brief Stops and joins the helper threads. Every task must have finished.
+     */
+    void stop();
+
+    /**
+     * @brief Adds a task to the back of a worker's deque.
+     *
+     * @param worker The worker that split the node.
+     * @param task The task to add.
+     */
+    void push(int worker, const SplitTask &task);
+
+    /**
+     * @brief Takes the newest task from a worker's own deque if it belongs to a split point.
+     *
+     * Only tasks of the given node are taken, so a worker waiting on a split
+     * never starts a sibling of a node further up its own stack.
+     *
+     * @param worker The worker taking the task.
+     * @param splitPoint The node the worker is waiting on.
+     * @param task Set to the task taken.
+     * @return true If a task was taken.
+     */
+    bool pop(int worker, const SplitPoint *splitPoint, SplitTask &task);
+
+    /**
+     * @brief Takes the oldest task from another worker's deque.
+     *
+     * @param worker The worker taking the task.
+     * @param task Set to the task taken.
+     * @return true If a task was taken.
+     */
+    bool steal(int worker, SplitTask &task);
+
+private:
+    /**
+     * @struct TaskDeque
+     * @brief A worker's tasks, on a cache line of its own.
+     */
+    struct alignas(64) TaskDeque
+    {
+        std::mutex mutex;
+        std::deque<SplitTask> tasks;
+    };
+
+    std::unique_ptr<TaskDeque[]> deques; ///< One deque per worker.
+    int workerCount = 0;                 ///< Number of workers, including the calling thread.
+    std::vector<std::thread> threads;    ///< The helper threads (workers 1 and up).
+    std::atomic<bool> running{false};    ///< Cleared to make the helper threads return.
+    TaskRunner runTask;                  ///< Searches a stolen task.
+
+    /**
+     * @brief Steals and runs tasks until the pool is stopped.
+     *
+     * @param worker The index of the helper thread.
+     */
+    void workerLoop(int worker);
+};
+
+#endif
@@ -0,0 +1,52 @@
+/**
+ * @file zobrist.h
+ * @author Seán Rourke
+ * @brief Defines the random keys used to hash chess positions.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "board.h"
+
+/**
+ * @struct ZobristKeys
+ * @brief Random 64-bit keys XORed together to form a position's hash.
+ */
+struct ZobristKeys
+{
+    uint64_t pieces[MAX_COLOUR][MAX_PIECE_TYPE][64]; ///< One key per colour, piece and square.
+    uint64_t castling[16];                          ///< One key per combination of castling rights.
+    uint64_t enPassant[BOARD_SIZE];                 ///< One key per en passant file.
+    uint64_t blackToMove;                           ///< Included when it is black's turn.
+};
+
+extern const ZobristKeys zobristKeys; ///< The keys, generated at compile time.
+
+/**
+ * @brief Gives the key for the castling rights still available.
+ *
+ * @param board The current state of the chessboard.
+ * @return uint64_t The key for the castling rights mask.
+ */
+inline uint64_t castlingHash(const Board &board)
+{
+    return zobristKeys.castling[board.castlingRights];
+}
+
+/**
+ * @brief Gives the key for the current en passant square.
+ *
+ * @param board The current state of the chessboard.
+ * @return uint64_t The key for the en passant file, or 0 if there is no en passant square.
+ */
+inline uint64_t enPassantHash(const Board &board)
+{
+    return (board.enPassantSquare == -1) ? 0 : zobristKeys.enPassant[board.enPassantSquare % BOARD_SIZE];
+}
+
+#endif
@@ -0,0 +1,253 @@
+/**
+ * @file attacks.cpp
+ * @author Seán Rourke
+ * @brief Implements attacks.h to build the leaper and magic bitboard attack tables.
+ * @date 2025
+ *
+ * Knight, king and pawn attacks are stored per square, and the between and
+ * line tables per pair of squares.
+ *
+ * For every square the relevant occupancy mask is enumerated, the attacks for
+ * each occupancy are computed by walking the rays once, and a magic number is
+ * searched for that maps every occupancy to a table entry without destructive
+ * collisions. Lookups after startup are a mask, multiply and shift.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "attacks.h"
+
+std::array<Magic, 64> bishopMagics;
+std::array<Magic, 64> rookMagics;
+std::array<Bitboard, 64> knightAttackTable;
+std::array<Bitboard, 64> kingAttackTable;
+std::array<std::array<Bitboard, 64>, MAX_COLOUR> pawnAttackTable;
+std::array<std::array<Bitboard, 64>, 64> betweenTable;
+std::array<std::array<Bitboard, 64>, 64> lineTable;
+
+namespace
+{
+    std::array<Bitboard, 5248> bishopTable;  ///< Shared bishop attack table for all squares.
+    std::array<Bitboard, 102400> rookTable;  ///< Shared rook attack table for all squares.
+
+    const int bishopDirections[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    const int rookDirections[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    const int knightSteps[8][2] = {{2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+    const int kingSteps[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+
+    /**
+     * @brief Collects the on-board squares reached by single steps from a square.
+     *
+     * @param square The square the piece is on.
+     * @param steps The rank/file offsets of each step.
+     * @param count The number of steps.
+     * @return Bitboard The reachable squares.
+     */
+    Bitboard leaperAttacks(int square, const int steps[][2], int count)
+    {
+        Bitboard attacks = 0;
+
+        for (int i = 0; i < count; ++i)
+        {
+            int newRank = square / BOARD_SIZE + steps[i][0];
+            int newFile = square % BOARD_SIZE + steps[i][1];
+
+            if (newRank >= 0 && newRank < BOARD_SIZE && newFile >= 0 && newFile < BOARD_SIZE)
+            {
+                attacks |= 1ULL << (newRank * BOARD_SIZE + newFile);
+            }
+        }
+
+        return attacks;
+    }
+
+    /**
+     * @brief Walks each ray from a square until it leaves the board or hits a blocker.
+     *
+     * @param square The square the slider is on.
+     * @param occupancy The occupied squares on the board.
+     * @param directions The four rank/file steps the slider moves in.
+     * @return Bitboard The attacked squares, including the first blocker in each direction.
+     */
+    Bitboard slidingAttacks(int square, Bitboard occupancy, const int directions[4][2])
+    {
+        Bitboard attacks = 0;
+
+        for (int d = 0; d < 4; ++d)
+        {
+            int newRank = square / BOARD_SIZE;
+            int newFile = square % BOARD_SIZE;
+
+            while (true)
+            {
+                newRank += directions[d][0];
+                newFile += directions[d][1];
+
+                if (newRank < 0 || newRank >= BOARD_SIZE || newFile < 0 || newFile >= BOARD_SIZE)
+                {
+                    break;
+                }
+
+                Bitboard target = 1ULL << (newRank * BOARD_SIZE + newFile);
+                attacks |= target;
+
+                if (occupancy & target)
+                {
+                    break;
+                }
+            }
+        }
+
+        return attacks;
+    }
+
+    /**
+     * @brief Small xorshift generator used to search for magic numbers.
+     *
+     * Seeded with a fixed value so the tables are identical on every run.
+     */
+    struct MagicRandom
+    {
+        uint64_t state;
+
+        uint64_t next()
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return state * 2685821657736338717ULL;
+        }
+
+        /**
+         * @brief Returns a random number with few bits set, which makes good magic candidates.
+         */
+        uint64_t sparse() { return next() & next() & next(); }
+    };
+
+    /**
+     * @brief Finds magic numbers and fills the attack table for one slider type.
+     *
+     * @param magics The per-square magic lookup data to fill in.
+     * @param table The shared attack table for this slider type.
+     * @param directions The four rank/file steps the slider moves in.
+     */
+    void initialiseMagics(std::array<Magic, 64> &magics, Bitboard *table, const int directions[4][2])
+    {
+        const Bitboard rank1 = 0x00000000000000FFULL;
+        const Bitboard rank8 = 0xFF00000000000000ULL;
+        const Bitboard fileA = 0x0101010101010101ULL;
+        const Bitboard fileH = 0x8080808080808080ULL;
+
+        std::array<Bitboard, 4096> occupancies;
+        std::array<Bitboard, 4096> references;
+        std::array<int, 4096> epoch = {};
+        int attempt = 0;
+        MagicRandom random{0x9E3779B97F4A7C15ULL};
+
+        Bitboard *slice = table;
+
+        for (int square = 0; square < 64; ++square)
+        {
+            Magic &m = magics[square];
+
+            // Edge squares never block a ray further, unless the slider is on that edge
+            Bitboard rank = rank1 << (8 * (square / BOARD_SIZE));
+            Bitboard file = fileA << (square % BOARD_SIZE);
+            Bitboard edges = ((rank1 | rank8) & ~rank) | ((fileA | fileH) & ~file);
+
+            m.mask = slidingAttacks(square, 0, directions) & ~edges;
+            m.shift = 64 - __builtin_popcountll(m.mask);
+            m.attacks = slice;
+
+            // Enumerate every subset of the mask using the Carry-Rippler trick
+            int size = 0;
+            Bitboard occupancy = 0;
+            do
+            {
+                occupancies[size] = occupancy;
+                references[size] = slidingAttacks(square, occupancy, directions);
+                ++size;
+                occupancy = (occupancy - m.mask) & m.mask;
+            } while (occupancy);
+
+            // Try random magics until every occupancy maps to a consistent entry
+            for (int i = 0; i < size;)
+            {
+                do
+                {
+                    m.magic = random.sparse();
+                } while (__builtin_popcountll((m.mask * m.magic) >> 56) < 6);
+
+                ++attempt;
+                for (i = 0; i < size; ++i)
+                {
+                    unsigned int index = m.index(occupancies[i]);
+
+                    if (epoch[index] < attempt)
+                    {
+                        epoch[index] = attempt;
+                        m.attacks[index] = references[i];
+                    }
+                    else if (m.attacks[index] != references[i])
+                    {
+                        break;
+                    }
+                }
+            }
+
+            slice += size;
+        }
+    }
+}
+
+/**
+ * @brief Builds the leaper and magic bitboard attack tables.
+ *
+ * Must be called once at startup before any attacks are looked up.
+ */
+void initialiseAttackTables()
+{
+    const int whitePawnSteps[2][2] = {{1, -1}, {1, 1}};
+    const int blackPawnSteps[2][2] = {{-1, -1}, {-1, 1}};
+
+    for (int square = 0; square < 64; ++square)
+    {
+        knightAttackTable[square] = leaperAttacks(square, knightSteps, 8);
+        kingAttackTable[square] = leaperAttacks(square, kingSteps, 8);
+        pawnAttackTable[WHITE][square] = leaperAttacks(square, whitePawnSteps, 2);
+        pawnAttackTable[BLACK][square] = leaperAttacks(square, blackPawnSteps, 2);
+    }
+
+    initialiseMagics(bishopMagics, bishopTable.data(), bishopDirections);
+    initialiseMagics(rookMagics, rookTable.data(), rookDirections);
+
+    // Squares on a shared line see each other on an empty board
+    for (int from = 0; from < 64; ++from)
+    {
+        for (int to = 0; to < 64; ++to)
+        {
+            Bitboard fromBB = 1ULL << from;
+            Bitboard toBB = 1ULL << to;
+
+            betweenTable[from][to] = 0;
+            lineTable[from][to] = 0;
+
+            if (from == to)
+            {
+                continue;
+            }
+
+            if (rookAttacks(from, 0) & toBB)
+            {
+                betweenTable[from][to] = rookAttacks(from, toBB) & rookAttacks(to, fromBB);
+                lineTable[from][to] = (rookAttacks(from, 0) & rookAttacks(to, 0)) | fromBB | toBB;
+            }
+            else if (bishopAttacks(from, 0) & toBB)
+            {
+                betweenTable[from][to] = bishopAttacks(from, toBB) & bishopAttacks(to, fromBB);
+                lineTable[from][to] = (bishopAttacks(from, 0) & bishopAttacks(to, 0)) | fromBB | toBB;
+            }
+        }
+    }
+}
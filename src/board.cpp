@@ -5,7 +5,7 @@
  * @date 2025
  *
  * This file implements board.h and sets up the chessboard with the standard
- * chess starting position.
+ * chess starting position, or any position given in FEN.
  *
  * It also updates the bitboards when a move is made.
  *
@@ -13,8 +13,14 @@
  *
  */
 
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
 #include "board.h"
 #include "move.h"
+#include "attacks.h"
+#include "pieceSquareTables.h"
+#include "zobrist.h"
 
 /**
  * @brief Construct a new Board:: Board object and initialises it.
@@ -30,82 +36,169 @@ Board::Board() { initialise(); }
  */
 void Board::initialise()
 {
-    bitboards[PAWN][WHITE] = 0x000000000000FF00;
-    bitboards[PAWN][BLACK] = 0x00FF000000000000;
+    bitboards[WHITE][PAWN] = 0x000000000000FF00;
+    bitboards[BLACK][PAWN] = 0x00FF000000000000;
 
-    bitboards[ROOK][WHITE] = 0x0000000000000081;
-    bitboards[ROOK][BLACK] = 0x8100000000000000;
+    bitboards[WHITE][ROOK] = 0x0000000000000081;
+    bitboards[BLACK][ROOK] = 0x8100000000000000;
 
-    bitboards[KNIGHT][WHITE] = 0x0000000000000042;
-    bitboards[KNIGHT][BLACK] = 0x4200000000000000;
+    bitboards[WHITE][KNIGHT] = 0x0000000000000042;
+    bitboards[BLACK][KNIGHT] = 0x4200000000000000;
 
-    bitboards[BISHOP][WHITE] = 0x0000000000000024;
-    bitboards[BISHOP][BLACK] = 0x2400000000000000;
+    bitboards[WHITE][BISHOP] = 0x0000000000000024;
+    bitboards[BLACK][BISHOP] = 0x2400000000000000;
 
-    bitboards[QUEEN][WHITE] = 0x0000000000000008;
-    bitboards[QUEEN][BLACK] = 0x0800000000000000;
+    bitboards[WHITE][QUEEN] = 0x0000000000000008;
+    bitboards[BLACK][QUEEN] = 0x0800000000000000;
 
-    bitboards[KING][WHITE] = 0x0000000000000010;
-    bitboards[KING][BLACK] = 0x1000000000000000;
+    bitboards[WHITE][KING] = 0x0000000000000010;
+    bitboards[BLACK][KING] = 0x1000000000000000;
 
-    pieces.fill(EMPTY);
+    // Fill the mailbox from the bitboards
+    mailbox.fill(NO_PIECE);
+    for (int colour = 0; colour < MAX_COLOUR; ++colour)
+    {
+        for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
+        {
+            Bitboard pieceBB = bitboards[colour][piece];
+            while (pieceBB)
+            {
+                int square = __builtin_ctzll(pieceBB);
+                pieceBB &= pieceBB - 1;
+                mailbox[square] = makePieceCode(static_cast<Piece>(piece), static_cast<Colour>(colour));
+            }
+        }
+    }
+
+    castlingRights = ALL_CASTLING;
+    hasCastled = {false, false};
+
+    enPassantSquare = -1;
+    currentColour = WHITE;
+
+    updateAggregateBitboards();
+    hashKey = computeHash();
+    pawnKey = computePawnKey();
+    pieceSquareScore = computePieceSquareScore();
+}
+
+/**
+ * @brief Sets up the board from a position in Forsyth-Edwards Notation.
+ *
+ * Reads the piece placement, side to move, castling rights and en passant
+ * square. The halfmove and fullmove counters are optional and ignored.
+ *
+ * @param fen The FEN string.
+ * @throws std::invalid_argument If the FEN string is malformed. The board is then left unchanged.
+ */
+void Board::loadFEN(const std::string &fen)
+{
+    std::istringstream iss(fen);
+    std::string placement, side, castling, enPassant;
+
+    if (!(iss >> placement >> side >> castling >> enPassant))
+    {
+        throw std::invalid_argument("Invalid FEN string");
+    }
+
+    const std::string pieceSymbols = "pnbrqk";
+
+    // Built on a copy so an invalid FEN leaves this board as it was
+    Board parsed;
+    for (auto &colourBitboards : parsed.bitboards)
+    {
+        colourBitboards.fill(0);
+    }
+    parsed.mailbox.fill(NO_PIECE);
 
-    for (int file = 0; file < BOARD_SIZE; ++file)
+    int rank = BOARD_SIZE - 1;
+    int file = 0;
+    for (char c : placement)
     {
-        pieces[file + 8] = PAWN;
-        pieces[file + 48] = PAWN;
+        if (c == '/')
+        {
+            --rank;
+            file = 0;
+        }
+        else if (c >= '1' && c <= '8')
+        {
+            file += c - '0';
+        }
+        else
+        {
+            std::size_t piece = pieceSymbols.find(static_cast<char>(std::tolower(c)));
+            if (piece == std::string::npos || rank < 0 || file >= BOARD_SIZE)
+            {
+                throw std::invalid_argument("Invalid FEN piece placement");
+            }
+
+            int square = rank * BOARD_SIZE + file;
+            Colour colour = std::isupper(c) ? WHITE : BLACK;
+            parsed.bitboards[colour][piece] |= 1ULL << square;
+            parsed.mailbox[square] = makePieceCode(static_cast<Piece>(piece), colour);
+            ++file;
+        }
     }
 
-    pieces[0] = ROOK;
-    pieces[7] = ROOK;
-    pieces[56] = ROOK;
-    pieces[63] = ROOK;
+    if (__builtin_popcountll(parsed.bitboards[WHITE][KING]) != 1 ||
+        __builtin_popcountll(parsed.bitboards[BLACK][KING]) != 1)
+    {
+        throw std::invalid_argument("Invalid FEN: each side needs exactly one king");
+    }
 
-    pieces[1] = KNIGHT;
-    pieces[6] = KNIGHT;
-    pieces[57] = KNIGHT;
-    pieces[62] = KNIGHT;
+    if (side != "w" && side != "b")
+    {
+        throw std::invalid_argument("Invalid FEN side to move");
+    }
+    parsed.currentColour = (side == "b") ? BLACK : WHITE;
 
-    pieces[2] = BISHOP;
-    pieces[5] = BISHOP;
-    pieces[58] = BISHOP;
-    pieces[61] = BISHOP;
+    parsed.castlingRights = 0;
+    if (castling.find('K') != std::string::npos)
+        parsed.castlingRights |= WHITE_KINGSIDE;
+    if (castling.find('Q') != std::string::npos)
+        parsed.castlingRights |= WHITE_QUEENSIDE;
+    if (castling.find('k') != std::string::npos)
+        parsed.castlingRights |= BLACK_KINGSIDE;
+    if (castling.find('q') != std::string::npos)
+        parsed.castlingRights |= BLACK_QUEENSIDE;
 
-    pieces[3] = QUEEN;
-    pieces[4] = KING;
-    pieces[59] = QUEEN;
-    pieces[60] = KING;
+    parsed.hasCastled = {false, false};
 
-    whiteCanCastleKingSide = true;
-    whiteCanCastleQueenSide = true;
-    blackCanCastleKingSide = true;
-    blackCanCastleQueenSide = true;
+    parsed.enPassantSquare = -1;
+    if (enPassant != "-")
+    {
+        if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' || enPassant[1] < '1' || enPassant[1] > '8')
+        {
+            throw std::invalid_argument("Invalid FEN en passant square");
+        }
+        parsed.enPassantSquare = (enPassant[1] - '1') * BOARD_SIZE + (enPassant[0] - 'a');
+    }
 
-    whiteHasCastled = false;
-    blackHasCastled = false;
+    parsed.updateAggregateBitboards();
+    parsed.hashKey = parsed.computeHash();
+    parsed.pawnKey = parsed.computePawnKey();
+    parsed.pieceSquareScore = parsed.computePieceSquareScore();
 
-    updateAggregateBitboards();
+    *this = parsed;
 }
 
 /**
  * @brief Updates the aggregate bitboards for all pieces.
  *
- * This function recalculates 'allPieces', 'whitePieces', and 'blackPieces'
- * by combining the bitboards of the individual pieces.
+ * This function recalculates 'allPieces' and 'colourPieces' by combining
+ * the bitboards of the individual pieces.
  */
 void Board::updateAggregateBitboards()
 {
-    whitePieces = 0;
-    blackPieces = 0;
-    allPieces = 0;
+    colourPieces = {0, 0};
 
     for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
     {
-        whitePieces |= bitboards[piece][WHITE];
-        blackPieces |= bitboards[piece][BLACK];
+        colourPieces[WHITE] |= bitboards[WHITE][piece];
+        colourPieces[BLACK] |= bitboards[BLACK][piece];
     }
 
-    allPieces = whitePieces | blackPieces;
+    allPieces = colourPieces[WHITE] | colourPieces[BLACK];
 }
 
 /**
@@ -143,7 +236,7 @@ void Board::printBoard() const
         for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
         {
             std::cout << colourPrefix[colour] << pieceSymbols[piece] << ":\n";
-            printBitboard(bitboards[piece][colour]);
+            printBitboard(bitboards[colour][piece]);
         }
     }
 }
@@ -157,6 +250,124 @@ void Board::printBoard() const
 int Board::kingSquare(Colour colour) const
 {
 
-    uint64_t kingBitboard = bitboards[KING][colour];
+    uint64_t kingBitboard = bitboards[colour][KING];
     return __builtin_ctzll(kingBitboard);
 }
+
+/**
+ * @brief Finds every piece of either colour attacking a square.
+ *
+ * The pawn tables are used in reverse: a white pawn attacks the square if a
+ * black pawn standing on the square would attack the white pawn.
+ *
+ * @param square The square being attacked.
+ * @param occupancy The occupied squares used to block sliding pieces.
+ * @return Bitboard The squares of all attacking pieces.
+ */
+Bitboard Board::attackersTo(int square, Bitboard occupancy) const
+{
+    Bitboard knights = bitboards[WHITE][KNIGHT] | bitboards[BLACK][KNIGHT];
+    Bitboard kings = bitboards[WHITE][KING] | bitboards[BLACK][KING];
+    Bitboard queens = bitboards[WHITE][QUEEN] | bitboards[BLACK][QUEEN];
+    Bitboard diagonalSliders = bitboards[WHITE][BISHOP] | bitboards[BLACK][BISHOP] | queens;
+    Bitboard straightSliders = bitboards[WHITE][ROOK] | bitboards[BLACK][ROOK] | queens;
+
+    return (pawnAttacks(BLACK, square) & bitboards[WHITE][PAWN]) |
+           (pawnAttacks(WHITE, square) & bitboards[BLACK][PAWN]) |
+           (knightAttacks(square) & knights) |
+           (kingAttacks(square) & kings) |
+           (bishopAttacks(square, occupancy) & diagonalSliders) |
+           (rookAttacks(square, occupancy) & straightSliders);
+}
+
+/**
+ * @brief Computes the Zobrist key of the position from scratch.
+ *
+ * Used to set up the key when the board is initialised, and to verify the
+ * incrementally updated key in debug builds.
+ *
+ * @return uint64_t The Zobrist key.
+ */
+uint64_t Board::computeHash() const
+{
+    uint64_t hash = 0;
+
+    for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
+    {
+        for (int colour = 0; colour < MAX_COLOUR; ++colour)
+        {
+            Bitboard pieceBB = bitboards[colour][piece];
+            while (pieceBB)
+            {
+                int square = __builtin_ctzll(pieceBB);
+                pieceBB &= pieceBB - 1;
+                hash ^= zobristKeys.pieces[colour][piece][square];
+            }
+        }
+    }
+
+    hash ^= castlingHash(*this);
+    hash ^= enPassantHash(*this);
+
+    if (currentColour == BLACK)
+    {
+        hash ^= zobristKeys.blackToMove;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Computes the Zobrist key of the pawns alone from scratch.
+ *
+ * The pawn key indexes the pawn structure cache, so it leaves out every other
+ * piece, the side to move, castling rights and the en passant square.
+ *
+ * @return uint64_t The pawn key (0 if there are no pawns).
+ */
+uint64_t Board::computePawnKey() const
+{
+    uint64_t hash = 0;
+
+    for (int colour = 0; colour < MAX_COLOUR; ++colour)
+    {
+        Bitboard pawns = bitboards[colour][PAWN];
+        while (pawns)
+        {
+            int square = __builtin_ctzll(pawns);
+            pawns &= pawns - 1;
+            hash ^= zobristKeys.pieces[colour][PAWN][square];
+        }
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Sums the material and piece-square values of the position from scratch.
+ *
+ * Used to set up the score when the board is initialised, and to verify the
+ * incrementally updated score in debug builds.
+ *
+ * @return PieceSquareScore The material, placement and game phase.
+ */
+PieceSquareScore Board::computePieceSquareScore() const
+{
+    PieceSquareScore score;
+
+    for (int colour = 0; colour < MAX_COLOUR; ++colour)
+    {
+        for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
+        {
+            Bitboard pieceBB = bitboards[colour][piece];
+            while (pieceBB)
+            {
+                int square = __builtin_ctzll(pieceBB);
+                pieceBB &= pieceBB - 1;
+                addPieceSquare(score, static_cast<Colour>(colour), static_cast<Piece>(piece), square);
+            }
+        }
+    }
+
+    return score;
+}
@@ -8,195 +8,99 @@
  *
  */
 
+#include <algorithm>
+#include <cassert>
 #include "evaluation.h"
-#include "moveValidation.h"
+#include "pieceSquareTables.h"
 
 /**
- * @brief Counts material value of each player.
+ * @brief Blends the middlegame and endgame piece-square sums by the game phase.
  *
- * @param board The current state of the chessboard.
- * @return float The evaluation of the material count.
+ * The phase falls from MAX_PHASE to 0 as pieces are traded, moving the weight
+ * from the middlegame tables to the endgame tables. Promotions can push it
+ * above MAX_PHASE, so it is capped.
+ *
+ * @param score The material, placement and game phase.
+ * @return Score The tapered score, positive if white is better.
  */
-float materialCount(const Board &board)
+Score taperedScore(const PieceSquareScore &score)
 {
-    constexpr int pieceValues[MAX_PIECE_TYPE] = {1, 3, 3, 5, 9, 10000};
-
-    int whiteMaterial = 0, blackMaterial = 0;
-
-    for (int piece = PAWN; piece < MAX_PIECE_TYPE; ++piece)
-    {
-        whiteMaterial += __builtin_popcountll(board.bitboards[piece][WHITE]) * pieceValues[piece];
-        blackMaterial += __builtin_popcountll(board.bitboards[piece][BLACK]) * pieceValues[piece];
-    }
-
-    return whiteMaterial - blackMaterial; // Positive if white is better, negative if black is better
+    int phase = std::min<int>(score.phase, MAX_PHASE);
+    return (score.middlegame * phase + score.endgame * (MAX_PHASE - phase)) / MAX_PHASE;
 }
 
 /**
- * @brief Counts number of pieces each player has in the centre of the board,
+ * @brief Evaluate the safety of each player's king.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of centre presence.
+ * @param pawns The evaluation of the board's pawn structure.
+ * @return Score The evaluation of king safety.
  */
-float centrePresence(const Board &board)
+Score kingSafety(const Board &board, PawnEntry &pawns)
 {
-    constexpr uint64_t centerMask = (1ULL << 27) | (1ULL << 28) | (1ULL << 35) | (1ULL << 36);
-    float score = 0.0f;
+    Score score = pawns.shield(board, WHITE) - pawns.shield(board, BLACK);
 
-    for (int piece = PAWN; piece < MAX_PIECE_TYPE; ++piece)
+    if (board.hasCastled[WHITE])
     {
-        uint64_t white = board.bitboards[piece][WHITE] & centerMask;
-        uint64_t black = board.bitboards[piece][BLACK] & centerMask;
-
-        score += 0.5f * __builtin_popcountll(white); // reward per white piece in center
-        score -= 0.5f * __builtin_popcountll(black); // penalize black controlling center
+        score += 50; // White castling
+    }
+    if (board.hasCastled[BLACK])
+    {
+        score -= 50; // Black castling
     }
 
     return score;
 }
 
-/**
- * @brief Counts number of pieces each player has attacking the centre of the board,
- *
- * @param board The current state of the chessboard.
- * @return float The evaluation of centre attacks.
- */
-float centreAttacks(const Board &board)
+namespace
 {
-    constexpr int centerSquares[4] = {27, 28, 35, 36};
-    float score = 0.0f;
-
-    for (int i = 0; i < 4; ++i)
+    /**
+     * @brief Combines the piece-square score with a pawn structure evaluation.
+     *
+     * @param board The current state of the chessboard.
+     * @param pieceSquareScore The material, placement and game phase of the board.
+     * @param pawns The evaluation of the board's pawn structure.
+     * @return Score The evaluation of the position, positive if white is better.
+     */
+    Score combine(const Board &board, PieceSquareScore pieceSquareScore, PawnEntry &pawns)
     {
-        int sq = centerSquares[i];
-
-        // If white attacks square
-        if (isSquareAttacked(sq, WHITE, board))
-            score += 0.3f;
-
-        if (isSquareAttacked(sq, BLACK, board))
-            score -= 0.3f;
+        pieceSquareScore.middlegame += pawns.middlegame;
+        pieceSquareScore.endgame += pawns.endgame;
+        return taperedScore(pieceSquareScore) + kingSafety(board, pawns);
     }
-
-    return score;
 }
 
 /**
- * @brief Evaluates how developed each player's pieces are.
+ * @brief Run all heuristic functions to determine evaluation.
  *
- * @param board The current state of the chessboard.
- * @return float The evaluation of development.
- */
-float development(const Board &board)
-{
-
-    float score = 0.0f;
-
-    // White minor pieces starting squares
-    if (!(board.bitboards[KNIGHT][WHITE] & (1ULL << 1)))
-        score += 0.3f; // b1
-    if (!(board.bitboards[KNIGHT][WHITE] & (1ULL << 6)))
-        score += 0.3f; // g1
-    if (!(board.bitboards[BISHOP][WHITE] & (1ULL << 2)))
-        score += 0.3f; // c1
-    if (!(board.bitboards[BISHOP][WHITE] & (1ULL << 5)))
-        score += 0.3f; // f1
-
-    // Black minor pieces starting squares
-    if (!(board.bitboards[KNIGHT][BLACK] & (1ULL << 57)))
-        score -= 0.3f; // b8
-    if (!(board.bitboards[KNIGHT][BLACK] & (1ULL << 62)))
-        score -= 0.3f; // g8
-    if (!(board.bitboards[BISHOP][BLACK] & (1ULL << 58)))
-        score -= 0.3f; // c8
-    if (!(board.bitboards[BISHOP][BLACK] & (1ULL << 61)))
-        score -= 0.3f; // f8
-
-    return score;
-}
-
-/**
- * @brief Evaluate the safety of each player's king.
+ * Material, centralisation and development come from the piece-square score
+ * kept up to date by makeMove. The pawn structure and shields come from the
+ * pawn table, which only evaluates a structure it has not seen before.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of king safety.
+ * @param pawnTable The calling thread's cache of pawn structure evaluations.
+ * @return Score The evaluation of the position.
  */
-float kingSafety(const Board &board)
+Score evaluation(const Board &board, PawnTable &pawnTable)
 {
-    float score = 0.0f;
-
-    // White king
-    int whiteKing = board.kingSquare(WHITE);
-    if (board.whiteHasCastled)
-    {
-        score += 0.5f; // White castling
-    }
+    Score eval = combine(board, board.pieceSquareScore, pawnTable.probe(board));
 
-    // Check white pawn shield
-    if (whiteKing == 6) // g1
-    {
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 13))
-            score += 0.2f; // f2
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 14))
-            score += 0.2f; // g2
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 15))
-            score += 0.2f; // h2
-    }
-    else if (whiteKing == 2) // c1
-    {
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 9))
-            score += 0.2f; // b2
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 10))
-            score += 0.2f; // c2
-        if (board.bitboards[PAWN][WHITE] & (1ULL << 11))
-            score += 0.2f; // d2
-    }
+#ifdef DEBUG_CHECKS
+    assert(eval == evaluationFromScratch(board) && "Incremental evaluation does not match evaluation from scratch");
+#endif
 
-    // Black king
-    int blackKing = board.kingSquare(BLACK);
-    if (board.blackHasCastled)
-    {
-        score -= 0.5f; // Black castling
-    }
-
-    // Check black pawn shield
-    if (blackKing == 62) // g8
-    {
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 53))
-            score -= 0.2f; // f7
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 54))
-            score -= 0.2f; // g7
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 55))
-            score -= 0.2f; // h7
-    }
-    else if (blackKing == 58) // c8
-    {
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 49))
-            score -= 0.2f; // b7
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 50))
-            score -= 0.2f; // c7
-        if (board.bitboards[PAWN][BLACK] & (1ULL << 51))
-            score -= 0.2f; // d7
-    }
-
-    return score;
+    return eval;
 }
 
 /**
- * @brief Run all heuristic functions to determine evaluation.
+ * @brief Evaluates the position without the incrementally updated scores, to check them.
  *
  * @param board The current state of the chessboard.
- * @return float The evaluation of the position.
+ * @return Score The evaluation of the position.
  */
-float evaluation(const Board &board)
+Score evaluationFromScratch(const Board &board)
 {
-    float eval = 0.0;
-
-    eval += materialCount(board);
-    eval += centrePresence(board);
-    eval += centreAttacks(board);
-    eval += development(board);
-    eval += kingSafety(board);
-
-    return eval;
+    PawnEntry pawns;
+    evaluatePawns(board, pawns);
+    return combine(board, board.computePieceSquareScore(), pawns);
 }
\ No newline at end of file
@@ -14,8 +14,11 @@
 #include <vector>
 #include <string>
 #include <sstream>
+#include <charconv>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <stdexcept>
 #include "board.h"
 #include "move.h"
 #include "moveGeneration.h"
@@ -24,104 +27,227 @@
 #include "moveValidation.h"
 #include "search.h"
 #include "uciConversion.h"
+#include "attacks.h"
+#include "transposition.h"
+#include "perft.h"
+#include "positionTracker.h"
+#include "searchThread.h"
 
 /**
- * @brief UCI protocol to receive move made in the lichess website and update board.
+ * @brief UCI protocol to receive the position from the lichess website and update board.
  *
  * @param chessBoard The current state of the chessboard.
- * @param input String sent by the lichess-bot api client containing the moves that have been made.
+ * @param tracker Remembers the moves already on the board so only new ones are played.
+ * @param input String sent by the lichess-bot api client containing the position and moves made.
  */
-void handlePosition(Board &chessBoard, const std::string &input)
+void handlePosition(Board &chessBoard, PositionTracker &tracker, const std::string &input)
 {
-    std::istringstream iss(input);
-    std::string token;
-    std::vector<std::string> moves;
-
-    while (iss >> token)
+    try
     {
-        if (token == "moves")
-        {
-            while (iss >> token)
-            {
-                moves.push_back(token);
-            }
-        }
+        tracker.update(chessBoard, input);
     }
-
-    if (!moves.empty())
+    catch (const std::invalid_argument &error)
     {
-        std::string lastMove = moves.back();
-        Move move = convertFromUCI(chessBoard, lastMove);
-        makeMove(chessBoard, move);
+        std::cout << "info string " + std::string(error.what()) + "\n" << std::flush;
     }
-    return;
 }
 
+const int MAX_MARGIN = 1000; ///< Largest value the pruning margin options accept.
+
 /**
- * @brief Search for best move for the bot to make using alpha beta.
+ * @brief Reads the value of a spin option, clamped to the range the option advertises.
  *
- * @param chessBoard The current state of the chessboard.
- * @param depth The number of moves to simulate ahead when searching.
+ * @param value The value token from the setoption command.
+ * @param min The smallest value the option accepts.
+ * @param max The largest value the option accepts.
+ * @param result Set to the clamped value if the token is a whole number.
+ * @return true If the token was a whole number.
+ * @return false If it was not, in which case result is unchanged.
  */
-std::string findBestMove(Board &chessBoard, int depth)
+bool readSpin(const std::string &value, int min, int max, int &result)
 {
-    std::vector<Move> moves = generateMoves(chessBoard.currentColour, chessBoard);
-    Move bestMove;
-    bestMove = moves[0];
-    if (moves.empty())
+    long long number = 0;
+    const char *end = value.data() + value.size();
+    auto [last, error] = std::from_chars(value.data(), end, number);
+    if (error == std::errc::result_out_of_range)
     {
-        std::string bestMoveString = "(none)";
-        return bestMoveString;
+        number = (value[0] == '-') ? min : max;
     }
-    float bestEval = (chessBoard.currentColour == WHITE) ? -1000000 : 1000000;
-    float alpha = -1000000;
-    float beta = 1000000;
+    else if (error != std::errc() || last != end)
+    {
+        std::cout << "info string Invalid value " + value + " for a spin option\n" << std::flush;
+        return false;
+    }
+
+    result = static_cast<int>(std::clamp<long long>(number, min, max));
+    return true;
+}
+
+/**
+ * @brief UCI protocol to change an engine option.
+ *
+ * Spin values are clamped to the advertised range, and a value that is not a
+ * number leaves the option unchanged.
+ *
+ * @param input String of the form "setoption name <id> value <x>".
+ */
+void handleSetOption(const std::string &input)
+{
+    std::istringstream iss(input);
+    std::string token, name, value;
 
-    for (const Move &move : moves)
+    iss >> token; // setoption
+    iss >> token; // name
+    while (iss >> token && token != "value")
     {
-        Board newBoard = chessBoard;
-        makeMove(newBoard, move);
+        name += (name.empty() ? "" : " ") + token;
+    }
+    iss >> value;
 
-        float eval = alphaBeta(newBoard, depth - 1, alpha, beta, chessBoard.currentColour == BLACK);
+    if (value.empty())
+    {
+        return;
+    }
 
-        if ((chessBoard.currentColour == WHITE && eval > bestEval) ||
-            (chessBoard.currentColour == BLACK && eval < bestEval))
+    if (name == "Hash")
+    {
+        int megabytes = TranspositionTable::DEFAULT_SIZE_MB;
+        if (readSpin(value, 1, TranspositionTable::MAX_SIZE_MB, megabytes))
         {
-            bestEval = eval;
-            bestMove = move;
+            transpositionTable.resize(megabytes);
         }
     }
-    makeMove(chessBoard, bestMove);
-    std::string bestMoveString = convertToUCI(bestMove);
-    return bestMoveString;
+    else if (name == "FutilityMargin")
+    {
+        readSpin(value, 0, MAX_MARGIN, searchParameters.futilityMargin);
+    }
+    else if (name == "ReverseFutilityMargin")
+    {
+        readSpin(value, 0, MAX_MARGIN, searchParameters.reverseFutilityMargin);
+    }
+    else if (name == "RazorMargin")
+    {
+        readSpin(value, 0, MAX_MARGIN, searchParameters.razorMargin);
+    }
+    else if (name == "Threads")
+    {
+        readSpin(value, 1, SearchParameters::MAX_THREADS, searchParameters.threads);
+    }
+    else if (name == "ParallelMode")
+    {
+        searchParameters.workStealing = (value == "YBWC");
+    }
+    else if (name == "SplitDepth")
+    {
+        readSpin(value, 1, MAX_SEARCH_DEPTH, searchParameters.splitDepth);
+    }
+}
+
+/**
+ * @brief Runs perft from the current position and reports the node counts and speed.
+ *
+ * Prints the node count below each root move, then the total, the time taken
+ * and the nodes per second.
+ *
+ * @param chessBoard The current state of the chessboard.
+ * @param input String of the form "go perft <depth>".
+ */
+void handlePerft(Board &chessBoard, const std::string &input)
+{
+    std::istringstream iss(input);
+    std::string token;
+    int depth = 1;
+
+    iss >> token >> token >> depth; // go perft <depth>
+    depth = std::max(1, depth);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t nodes = perftDivide(chessBoard, depth, std::cout);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    uint64_t milliseconds = std::max<int64_t>(1, elapsed.count());
+    std::cout << "\nNodes searched: " << nodes << "\n";
+    std::cout << "Time: " << elapsed.count() << " ms\n";
+    std::cout << "NPS: " << nodes * 1000 / milliseconds << std::endl;
 }
 
 /**
  * @brief UCI protocol to respond when it is bot's turn to move.
  *
+ * Reads the clock and depth limits from the go command. If none are given the
+ * search stops at the default depth. A ponder search ignores the clock until
+ * ponderhit, when it goes on as a timed search. The search runs on the
+ * search thread, which prints the bestmove when it finishes, so this
+ * returns at once.
+ *
  * @param chessBoard The current state of the chessboard.
- * @param depth The number of moves to simulate ahead when searching.
+ * @param searchThread The thread to run the search on.
+ * @param input String of the form "go [wtime <x>] [btime <x>] [winc <x>] [binc <x>] ...".
+ * @param defaultDepth The depth to search when the command gives no limits.
  */
-void handleGo(Board &chessBoard, int depth)
+void handleGo(const Board &chessBoard, SearchThread &searchThread, const std::string &input, int defaultDepth)
 {
-    // std::this_thread::sleep_for(std::chrono::seconds(1));
-    std::string bestMoveString = findBestMove(chessBoard, depth);
-    std::cout << "bestmove " << bestMoveString << std::endl;
-    return;
+    std::istringstream iss(input);
+    std::string token;
+    SearchLimits limits;
+    bool limited = false;
+
+    iss >> token; // go
+    while (iss >> token)
+    {
+        if (token == "wtime")
+            iss >> limits.whiteTime;
+        else if (token == "btime")
+            iss >> limits.blackTime;
+        else if (token == "winc")
+            iss >> limits.whiteIncrement;
+        else if (token == "binc")
+            iss >> limits.blackIncrement;
+        else if (token == "movestogo")
+            iss >> limits.movesToGo;
+        else if (token == "movetime")
+            iss >> limits.moveTime;
+        else if (token == "depth")
+            iss >> limits.depth;
+        else if (token == "infinite")
+            limits.infinite = true;
+        else if (token == "ponder")
+            limits.ponder = true;
+        else
+            continue;
+
+        limited = true;
+    }
+
+    if (!limited)
+    {
+        limits.depth = defaultDepth;
+    }
+    limits.depth = std::max(1, std::min(limits.depth, MAX_SEARCH_DEPTH));
+
+    searchThread.go(chessBoard, limits);
 }
 
 /**
  * @brief Main function to receive and respond to UCI commands.
+ *
+ * Searches run on a separate thread, so commands such as "isready" and
+ * "stop" are answered while the engine is thinking. Commands that change
+ * state the search reads stop the search and wait for its bestmove first, so
+ * an infinite or ponder search cannot leave the loop blocked.
  */
 int main()
 {
+    initialiseAttackTables();
+    initialiseSearch();
 
     Board chessBoard;
     chessBoard.initialise();
+    PositionTracker tracker;
+    SearchThread searchThread;
     // chessBoard.printBoard();
     int depth = 4;
     std::string input;
-    std::cout.sync_with_stdio(false);
 
     while (std::getline(std::cin, input))
     {
@@ -129,22 +255,66 @@ int main()
         {
             std::cout << "id name Herm0ni" << std::endl;
             std::cout << "id author Sean Rourke" << std::endl;
+            std::cout << "option name Ponder type check default false" << std::endl;
+            std::cout << "option name Hash type spin default " << TranspositionTable::DEFAULT_SIZE_MB
+                      << " min 1 max " << TranspositionTable::MAX_SIZE_MB << std::endl;
+            std::cout << "option name FutilityMargin type spin default " << searchParameters.futilityMargin
+                      << " min 0 max " << MAX_MARGIN << std::endl;
+            std::cout << "option name ReverseFutilityMargin type spin default " << searchParameters.reverseFutilityMargin
+                      << " min 0 max " << MAX_MARGIN << std::endl;
+            std::cout << "option name RazorMargin type spin default " << searchParameters.razorMargin
+                      << " min 0 max " << MAX_MARGIN << std::endl;
+            std::cout << "option name Threads type spin default " << searchParameters.threads
+                      << " min 1 max " << SearchParameters::MAX_THREADS << std::endl;
+            std::cout << "option name ParallelMode type combo default LazySMP var LazySMP var YBWC" << std::endl;
+            std::cout << "option name SplitDepth type spin default " << searchParameters.splitDepth
+                      << " min 1 max " << MAX_SEARCH_DEPTH << std::endl;
             std::cout << "uciok" << std::endl;
         }
         else if (input == "isready")
         {
-            std::cout << "readyok" << std::endl;
+            std::cout << "readyok\n" << std::flush;
+        }
+        else if (input == "ucinewgame")
+        {
+            searchThread.stop();
+            searchThread.wait();
+            // A new game starts cold, so its searches do not depend on the previous game
+            tracker.reset();
+            transpositionTable.clear();
+            clearPawnTables();
         }
         else if (input.rfind("position", 0) == 0)
         {
-            handlePosition(chessBoard, input);
+            handlePosition(chessBoard, tracker, input);
+        }
+        else if (input.rfind("setoption", 0) == 0)
+        {
+            searchThread.stop();
+            searchThread.wait();
+            handleSetOption(input);
+        }
+        else if (input.rfind("go perft", 0) == 0)
+        {
+            searchThread.stop();
+            searchThread.wait();
+            handlePerft(chessBoard, input);
         }
         else if (input.rfind("go", 0) == 0)
         {
-            handleGo(chessBoard, depth);
+            handleGo(chessBoard, searchThread, input, depth);
+        }
+        else if (input == "stop")
+        {
+            searchThread.stop();
+        }
+        else if (input == "ponderhit")
+        {
+            searchThread.ponderHit();
         }
         else if (input == "quit")
         {
+            searchThread.stop();
             break;
         }
     }
@@ -1,138 +1,323 @@
 /**
  * @file makeMove.cpp
  * @author Seán Rourke
- * @brief Updates bitboards to represent selected move.
+ * @brief Updates bitboards to represent selected move, or to take it back.
  * @date 2025
  *
  * @copyright Copyright (c) 2025
  *
  */
 
+#include <cassert>
 #include "makeMove.h"
+#include "pieceSquareTables.h"
+#include "zobrist.h"
+
+namespace
+{
+   /**
+    * @brief Castling rights kept when a piece moves from or to each square.
+    *
+    * Moving the king loses both of that side's rights, and moving a rook from
+    * its corner or capturing a rook on its corner loses that corner's right.
+    */
+   const std::array<uint8_t, 64> castlingRightsMask = []()
+   {
+      std::array<uint8_t, 64> mask;
+      mask.fill(ALL_CASTLING);
+      mask[0] &= ~WHITE_QUEENSIDE;
+      mask[7] &= ~WHITE_KINGSIDE;
+      mask[4] &= ~(WHITE_KINGSIDE | WHITE_QUEENSIDE);
+      mask[56] &= ~BLACK_QUEENSIDE;
+      mask[63] &= ~BLACK_KINGSIDE;
+      mask[60] &= ~(BLACK_KINGSIDE | BLACK_QUEENSIDE);
+      return mask;
+   }();
+
+   /**
+    * @brief Finds the rook's start and end squares for a castling move.
+    *
+    * @param kingTo The square the king castles to.
+    * @param rookFrom Set to the rook's starting square.
+    * @param rookTo Set to the rook's destination square.
+    */
+   void castlingRookSquares(int kingTo, int &rookFrom, int &rookTo)
+   {
+      if (kingTo == 62) // Black kingside castling
+         rookFrom = 63, rookTo = 61;
+      else if (kingTo == 58) // Black queenside castling
+         rookFrom = 56, rookTo = 59;
+      else if (kingTo == 6) // White kingside castling
+         rookFrom = 7, rookTo = 5;
+      else // White queenside castling
+         rookFrom = 0, rookTo = 3;
+   }
+
+#ifdef DEBUG_CHECKS
+   /**
+    * @brief Checks the incrementally updated occupancy bitboards against a full rebuild.
+    *
+    * @param board The current state of the chessboard.
+    * @return true If the colour and occupancy bitboards match the piece bitboards.
+    */
+   bool aggregatesMatch(const Board &board)
+   {
+      Board rebuilt = board;
+      rebuilt.updateAggregateBitboards();
+      return rebuilt.colourPieces == board.colourPieces && rebuilt.allPieces == board.allPieces;
+   }
+#endif
+}
 
 /**
  * @brief Update bitboards to represent a move being made.
  *
  * @param board The current state of the chessboard.
  * @param move The selected move to be made.
+ * @return MoveHistory The state needed to unmake the move.
  */
-void makeMove(Board &board, const Move &move)
+MoveHistory makeMove(Board &board, const Move &move)
 {
-   int fromSquare = move.from;
-   int toSquare = move.to;
+   int fromSquare = move.from();
+   int toSquare = move.to();
+
+   Piece pieceType = board.pieceOn(fromSquare);
+   Piece capturedPiece = board.pieceOn(toSquare);
+
+   MoveHistory history;
+   history.move = move;
+   history.capturedPiece = capturedPiece;
+   history.castlingRights = board.castlingRights;
+   history.enPassantSquare = board.enPassantSquare;
+   history.hasCastled = board.hasCastled;
+   history.hashKey = board.hashKey;
+   history.pawnKey = board.pawnKey;
+   history.pieceSquareScore = board.pieceSquareScore;
+
+   Colour colour = board.currentColour;
+   Colour opponent = (colour == WHITE) ? BLACK : WHITE;
+
+   Bitboard fromBB = 1ULL << fromSquare;
+   Bitboard toBB = 1ULL << toSquare;
 
-   Piece pieceType = board.pieces[fromSquare];
+   // The mover leaves its square and arrives on the target
+   board.colourPieces[colour] ^= fromBB | toBB;
+   board.allPieces ^= fromBB | toBB;
+
+   // Remove the old castling rights and en passant square from the key
+   board.hashKey ^= castlingHash(board) ^ enPassantHash(board);
 
    // Remove the piece from its original position in the bitboard
-   board.bitboards[pieceType][board.currentColour] &= ~(1ULL << fromSquare);
+   board.bitboards[colour][pieceType] &= ~(1ULL << fromSquare);
+   board.hashKey ^= zobristKeys.pieces[colour][pieceType][fromSquare];
+   removePieceSquare(board.pieceSquareScore, colour, pieceType, fromSquare);
+   if (pieceType == PAWN)
+      board.pawnKey ^= zobristKeys.pieces[colour][PAWN][fromSquare];
 
    // Handle captures
-   Piece capturedPiece = board.pieces[toSquare];
    if (capturedPiece != EMPTY)
    {
-      board.bitboards[capturedPiece][!board.currentColour] &= ~(1ULL << toSquare);
+      board.bitboards[opponent][capturedPiece] &= ~(1ULL << toSquare);
+      board.hashKey ^= zobristKeys.pieces[opponent][capturedPiece][toSquare];
+      removePieceSquare(board.pieceSquareScore, opponent, capturedPiece, toSquare);
+      if (capturedPiece == PAWN)
+         board.pawnKey ^= zobristKeys.pieces[opponent][PAWN][toSquare];
+
+      // The target stays occupied, now by the mover
+      board.colourPieces[opponent] ^= toBB;
+      board.allPieces ^= toBB;
    }
 
-   // Handle promotions
-   if (move.promotionPiece != -1)
+   // Handle en passant
+   if (move.enPassant())
    {
-      Piece promotedPiece = static_cast<Piece>(move.promotionPiece);
-      board.pieces[toSquare] = promotedPiece;
-      board.bitboards[promotedPiece][board.currentColour] |= (1ULL << toSquare);
+      int capturedPawnSquare = toSquare + ((colour == WHITE) ? -8 : 8);
+      board.mailbox[capturedPawnSquare] = NO_PIECE;
+      board.bitboards[opponent][PAWN] &= ~(1ULL << capturedPawnSquare);
+      board.hashKey ^= zobristKeys.pieces[opponent][PAWN][capturedPawnSquare];
+      board.pawnKey ^= zobristKeys.pieces[opponent][PAWN][capturedPawnSquare];
+      removePieceSquare(board.pieceSquareScore, opponent, PAWN, capturedPawnSquare);
+      board.colourPieces[opponent] ^= 1ULL << capturedPawnSquare;
+      board.allPieces ^= 1ULL << capturedPawnSquare;
    }
-   else
+
+   // Move the piece to its new position, promoting it if needed
+   Piece placedPiece = move.isPromotion() ? static_cast<Piece>(move.promotionPiece()) : pieceType;
+   board.mailbox[toSquare] = makePieceCode(placedPiece, colour);
+   board.bitboards[colour][placedPiece] |= (1ULL << toSquare);
+   board.hashKey ^= zobristKeys.pieces[colour][placedPiece][toSquare];
+   addPieceSquare(board.pieceSquareScore, colour, placedPiece, toSquare);
+   if (placedPiece == PAWN)
+      board.pawnKey ^= zobristKeys.pieces[colour][PAWN][toSquare];
+
+   // Set the enPassantSquare for two-square pawn moves, and clear it for any other move
+   board.enPassantSquare = move.doublePush() ? static_cast<int8_t>((fromSquare + toSquare) / 2) : -1;
+
+   // Handle castling
+   if (move.castling())
    {
+      int rookFrom, rookTo;
+      castlingRookSquares(toSquare, rookFrom, rookTo);
 
-      // Handle en passant
-      if (pieceType == PAWN && toSquare == board.enPassantSquare)
-      {
-         int capturedPawnSquare = toSquare + ((board.currentColour == WHITE) ? -8 : 8);
-         board.pieces[capturedPawnSquare] = EMPTY;
-         board.bitboards[PAWN][!board.currentColour] &= ~(1ULL << capturedPawnSquare);
-      }
-
-      // Move the piece to its new position
-      board.pieces[toSquare] = pieceType;
-      board.bitboards[pieceType][board.currentColour] |= (1ULL << toSquare);
-
-      // Set the enPassantSquare for two-square pawn moves
-      if (pieceType == PAWN && (fromSquare + 16 == toSquare || fromSquare - 16 == toSquare))
-      {
-         board.enPassantSquare = (board.currentColour == WHITE) ? toSquare - 8 : toSquare + 8;
-      }
-      else
-      {
-         // Clear enPassantSquare for any other move
-         board.enPassantSquare = -1;
-      }
-
-      // Handle castling
-      if (pieceType == KING)
-      {
-         if (move.castling)
-         {
-            int rookFrom, rookTo;
-            if (toSquare == 62) // Black queenside castling
-               rookFrom = 63, rookTo = 61;
-            else if (toSquare == 58) // Black kingside castling
-               rookFrom = 56, rookTo = 59;
-            else if (toSquare == 6) // White kingside castling
-               rookFrom = 7, rookTo = 5;
-            else if (toSquare == 2) // White queenside castling
-               rookFrom = 0, rookTo = 3;
-
-            board.pieces[rookFrom] = EMPTY;
-            board.pieces[rookTo] = ROOK;
-            board.bitboards[ROOK][board.currentColour] &= ~(1ULL << rookFrom);
-            board.bitboards[ROOK][board.currentColour] |= (1ULL << rookTo);
-         }
-         if (board.currentColour == WHITE)
-         {
-            board.whiteCanCastleKingSide = false;
-            board.whiteCanCastleQueenSide = false;
-            board.whiteHasCastled = true;
-         }
-         else
-         {
-            board.blackCanCastleKingSide = false;
-            board.blackCanCastleQueenSide = false;
-            board.blackHasCastled = true;
-         }
-      }
-
-      // Remove castling rights for a side if a rook moves
-      if (pieceType == ROOK)
-      {
-         if (board.currentColour == WHITE)
-         {
-            if (fromSquare == 0 && board.whiteCanCastleQueenSide)
-            {
-               board.whiteCanCastleQueenSide = false;
-            }
-            else if (fromSquare == 7 && board.whiteCanCastleKingSide)
-            {
-               board.whiteCanCastleKingSide = false;
-            }
-         }
-         else
-         {
-            if (fromSquare == 63 && board.blackCanCastleKingSide)
-            {
-               board.blackCanCastleKingSide = false;
-            }
-            else if (fromSquare == 56 && board.blackCanCastleQueenSide)
-            {
-               board.blackCanCastleQueenSide = false;
-            }
-         }
-      }
+      board.mailbox[rookFrom] = NO_PIECE;
+      board.mailbox[rookTo] = makePieceCode(ROOK, colour);
+      Bitboard rookMove = (1ULL << rookFrom) | (1ULL << rookTo);
+      board.bitboards[colour][ROOK] ^= rookMove;
+      board.colourPieces[colour] ^= rookMove;
+      board.allPieces ^= rookMove;
+      board.hashKey ^= zobristKeys.pieces[colour][ROOK][rookFrom] ^ zobristKeys.pieces[colour][ROOK][rookTo];
+      removePieceSquare(board.pieceSquareScore, colour, ROOK, rookFrom);
+      addPieceSquare(board.pieceSquareScore, colour, ROOK, rookTo);
+   }
+
+   if (pieceType == KING)
+   {
+      board.hasCastled[colour] = true;
    }
-   // Clear the original square
-   board.pieces[fromSquare] = EMPTY;
 
-   // Update bitboards
-   board.updateAggregateBitboards();
+   // Remove castling rights for a king move, or a rook leaving or captured on its corner
+   board.castlingRights &= castlingRightsMask[fromSquare] & castlingRightsMask[toSquare];
+
+   // Clear the original square
+   board.mailbox[fromSquare] = NO_PIECE;
 
    // Switch turns
+   board.currentColour = opponent;
+
+   // Add the new castling rights, en passant square and side to move to the key
+   board.hashKey ^= castlingHash(board) ^ enPassantHash(board) ^ zobristKeys.blackToMove;
+
+#ifdef DEBUG_CHECKS
+   assert(board.hashKey == board.computeHash() && "Incremental Zobrist key does not match recomputed key");
+   assert(aggregatesMatch(board) && "Incremental occupancy does not match the piece bitboards");
+   assert(board.pieceSquareScore == board.computePieceSquareScore() &&
+          "Incremental piece-square score does not match recomputed score");
+   assert(board.pawnKey == board.computePawnKey() && "Incremental pawn key does not match recomputed key");
+#endif
+
+   return history;
+}
+
+/**
+ * @brief Restore the board to its state before a move was made.
+ *
+ * Reverses the piece movement, restores any captured piece (including a pawn
+ * taken en passant), moves the rook back after castling and restores the
+ * castling rights and en passant square saved in the history.
+ *
+ * @param board The current state of the chessboard.
+ * @param history The history returned by makeMove for the move being unmade.
+ */
+void unmakeMove(Board &board, const MoveHistory &history)
+{
+   const Move &move = history.move;
+   int fromSquare = move.from();
+   int toSquare = move.to();
+
+   // Switch turns back to the player who made the move
+   board.currentColour = (board.currentColour == WHITE) ? BLACK : WHITE;
+   Colour colour = board.currentColour;
+   Colour opponent = (colour == WHITE) ? BLACK : WHITE;
+
+   Piece pieceOnTarget = board.pieceOn(toSquare);
+   Piece pieceType = move.isPromotion() ? PAWN : pieceOnTarget;
+
+   Bitboard fromBB = 1ULL << fromSquare;
+   Bitboard toBB = 1ULL << toSquare;
+
+   // Move the piece back to its original square
+   board.colourPieces[colour] ^= fromBB | toBB;
+   board.allPieces ^= fromBB | toBB;
+   board.bitboards[colour][pieceOnTarget] &= ~(1ULL << toSquare);
+   board.bitboards[colour][pieceType] |= (1ULL << fromSquare);
+   board.mailbox[fromSquare] = makePieceCode(pieceType, colour);
+
+   // Restore any captured piece
+   board.mailbox[toSquare] = NO_PIECE;
+   if (history.capturedPiece != EMPTY)
+   {
+      board.mailbox[toSquare] = makePieceCode(history.capturedPiece, opponent);
+      board.bitboards[opponent][history.capturedPiece] |= (1ULL << toSquare);
+      board.colourPieces[opponent] ^= toBB;
+      board.allPieces ^= toBB;
+   }
+
+   // Restore a pawn captured en passant
+   if (move.enPassant())
+   {
+      int capturedPawnSquare = toSquare + ((colour == WHITE) ? -8 : 8);
+      board.mailbox[capturedPawnSquare] = makePieceCode(PAWN, opponent);
+      board.bitboards[opponent][PAWN] |= (1ULL << capturedPawnSquare);
+      board.colourPieces[opponent] ^= 1ULL << capturedPawnSquare;
+      board.allPieces ^= 1ULL << capturedPawnSquare;
+   }
+
+   // Move the rook back after castling
+   if (move.castling())
+   {
+      int rookFrom, rookTo;
+      castlingRookSquares(toSquare, rookFrom, rookTo);
+
+      board.mailbox[rookTo] = NO_PIECE;
+      board.mailbox[rookFrom] = makePieceCode(ROOK, colour);
+      Bitboard rookMove = (1ULL << rookFrom) | (1ULL << rookTo);
+      board.bitboards[colour][ROOK] ^= rookMove;
+      board.colourPieces[colour] ^= rookMove;
+      board.allPieces ^= rookMove;
+   }
+
+   board.castlingRights = history.castlingRights;
+   board.hasCastled = history.hasCastled;
+   board.enPassantSquare = history.enPassantSquare;
+   board.hashKey = history.hashKey;
+   board.pawnKey = history.pawnKey;
+   board.pieceSquareScore = history.pieceSquareScore;
+
+#ifdef DEBUG_CHECKS
+   assert(aggregatesMatch(board) && "Incremental occupancy does not match the piece bitboards");
+#endif
+}
+
+/**
+ * @brief Passes the turn to the opponent without moving a piece.
+ *
+ * Only the side to move and the en passant square change.
+ *
+ * @param board The current state of the chessboard.
+ * @return MoveHistory The state needed to unmake the null move.
+ */
+MoveHistory makeNullMove(Board &board)
+{
+   MoveHistory history;
+   history.move = Move();
+   history.capturedPiece = EMPTY;
+   history.castlingRights = board.castlingRights;
+   history.enPassantSquare = board.enPassantSquare;
+   history.hasCastled = board.hasCastled;
+   history.hashKey = board.hashKey;
+   history.pawnKey = board.pawnKey;
+   history.pieceSquareScore = board.pieceSquareScore;
+
+   board.hashKey ^= enPassantHash(board) ^ zobristKeys.blackToMove;
+   board.enPassantSquare = -1;
+   board.currentColour = (board.currentColour == WHITE) ? BLACK : WHITE;
+
+#ifdef DEBUG_CHECKS
+   assert(board.hashKey == board.computeHash() && "Incremental Zobrist key does not match recomputed key");
+#endif
+
+   return history;
+}
+
+/**
+ * @brief Restore the board to its state before a null move was made.
+ *
+ * @param board The current state of the chessboard.
+ * @param history The history returned by makeNullMove.
+ */
+void unmakeNullMove(Board &board, const MoveHistory &history)
+{
    board.currentColour = (board.currentColour == WHITE) ? BLACK : WHITE;
+   board.enPassantSquare = history.enPassantSquare;
+   board.hashKey = history.hashKey;
 }
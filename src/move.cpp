@@ -21,11 +21,13 @@
  */
 std::ostream &operator<<(std::ostream &os, const Move &move)
 {
-    os << "Move(" << move.from << " -> " << move.to;
-    if (move.promotionPiece != -1)
-        os << ", Promotion: " << move.promotionPiece;
-    if (move.castling)
+    os << "Move(" << move.from() << " -> " << move.to();
+    if (move.isPromotion())
+        os << ", Promotion: " << move.promotionPiece();
+    if (move.castling())
         os << ", Castling";
+    if (move.enPassant())
+        os << ", En Passant";
     os << ")";
     return os;
 }
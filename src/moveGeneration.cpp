@@ -4,7 +4,12 @@
  * @brief Generates moves for each type of piece.
  * @date 2025
  *
- * Generates moves for each piece type, or vector of all moves for a player.
+ * Generates moves for each piece type, or a list of all moves for a player.
+ *
+ * Only legal moves are produced. generateMoves works out once per position
+ * which pieces are pinned and which squares resolve a check, and passes each
+ * piece generator a target mask so moves that would expose the king are never
+ * generated. King moves and en passant are tested individually.
  *
  * @copyright Copyright (c) 2025
  *
@@ -12,6 +17,48 @@
 
 #include "moveGeneration.h"
 #include "moveValidation.h"
+#include "attacks.h"
+
+/**
+ * @brief Appends a pawn move, expanding it into all four promotions on the last rank.
+ *
+ * @param from The square the pawn moves from.
+ * @param to The square the pawn moves to.
+ * @param promotion Whether the pawn reaches the last rank.
+ * @param moves The list the move is appended to.
+ */
+static void addPawnMove(int from, int to, bool promotion, MoveList &moves)
+{
+    if (promotion)
+    {
+        moves.push_back({from, to, QUEEN});
+        moves.push_back({from, to, ROOK});
+        moves.push_back({from, to, BISHOP});
+        moves.push_back({from, to, KNIGHT});
+    }
+    else
+    {
+        moves.push_back({from, to});
+    }
+}
+
+/**
+ * @brief Appends a move from a square to every square in a target bitboard.
+ *
+ * @param from The square the piece moves from.
+ * @param targets The squares the piece can move to.
+ * @param moves The list the moves are appended to.
+ */
+static void addMoves(int from, Bitboard targets, MoveList &moves)
+{
+    while (targets)
+    {
+        int toSquare = __builtin_ctzll(targets);
+        targets &= targets - 1;
+
+        moves.push_back({from, toSquare});
+    }
+}
 
 /**
  * @brief Generates legal moves for a pawn.
@@ -20,91 +67,55 @@
  * @param file The file of the pawn.
  * @param colour The colour of the pawn (WHITE or BLACK).
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the pawn.
+ * @param targetMask The squares the pawn may move to without exposing its king.
+ * @param moves The list the pawn's moves are appended to.
  */
-std::vector<Move> generatePawnMoves(int rank, int file, Colour colour, const Board &board)
+void generatePawnMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves)
 {
-    std::vector<Move> moves;
-
+    int fromSquare = rank * BOARD_SIZE + file;
     int forward = (colour == WHITE) ? 1 : -1;
     int startRank = (colour == WHITE) ? 1 : 6;
     int promotionRank = (colour == WHITE) ? 7 : 0;
 
-    Bitboard enemyPieces = (colour == WHITE) ? board.blackPieces : board.whitePieces;
+    Bitboard enemyPieces = board.colourPieces[!colour];
 
     int forwardRank = rank + forward;
-    if (forwardRank >= 0 && forwardRank < BOARD_SIZE)
+    bool promotion = forwardRank == promotionRank;
+
+    int forwardSquare = forwardRank * BOARD_SIZE + file;
+    if (!(board.allPieces & (1ULL << forwardSquare)))
     {
-        int forwardSquare = forwardRank * BOARD_SIZE + file;
-        if (!(board.allPieces & (1ULL << forwardSquare)))
+        if (targetMask & (1ULL << forwardSquare))
         {
-            if (forwardRank == promotionRank)
-            {
-                moves.push_back({rank * BOARD_SIZE + file, forwardSquare, QUEEN});
-                moves.push_back({rank * BOARD_SIZE + file, forwardSquare, ROOK});
-                moves.push_back({rank * BOARD_SIZE + file, forwardSquare, BISHOP});
-                moves.push_back({rank * BOARD_SIZE + file, forwardSquare, KNIGHT});
-            }
-            else
-            {
-                moves.push_back({rank * BOARD_SIZE + file, forwardSquare});
-            }
+            addPawnMove(fromSquare, forwardSquare, promotion, moves);
+        }
 
-            if (rank == startRank)
+        if (rank == startRank)
+        {
+            int doubleForwardSquare = (rank + 2 * forward) * BOARD_SIZE + file;
+            if (!(board.allPieces & (1ULL << doubleForwardSquare)) && (targetMask & (1ULL << doubleForwardSquare)))
             {
-                int singleForwardRank = rank + forward;
-                int singleForwardSquare = singleForwardRank * BOARD_SIZE + file;
-                int doubleForwardRank = rank + 2 * forward;
-                int doubleForwardSquare = doubleForwardRank * BOARD_SIZE + file;
-                if (!(board.allPieces & (1ULL << singleForwardSquare)) &&
-                    !(board.allPieces & (1ULL << doubleForwardSquare)))
-                {
-                    moves.push_back({rank * BOARD_SIZE + file, doubleForwardSquare});
-                }
+                moves.push_back({fromSquare, doubleForwardSquare, DOUBLE_PUSH});
             }
         }
     }
 
-    for (int side = -1; side <= 1; side += 2)
+    Bitboard captures = pawnAttacks(colour, fromSquare) & enemyPieces & targetMask;
+    while (captures)
     {
+        int captureSquare = __builtin_ctzll(captures);
+        captures &= captures - 1;
 
-        int captureFile = file + side;
-
-        if (captureFile >= 0 && captureFile < BOARD_SIZE)
-        {
-
-            int captureSquare = forwardRank * BOARD_SIZE + captureFile;
-
-            if (enemyPieces & (1ULL << captureSquare))
-            {
-
-                if (forwardRank == promotionRank)
-                {
-
-                    moves.push_back({rank * BOARD_SIZE + file, captureSquare, QUEEN});
-                    moves.push_back({rank * BOARD_SIZE + file, captureSquare, ROOK});
-                    moves.push_back({rank * BOARD_SIZE + file, captureSquare, BISHOP});
-                    moves.push_back({rank * BOARD_SIZE + file, captureSquare, KNIGHT});
-                }
-                else
-                {
-                    moves.push_back({rank * BOARD_SIZE + file, captureSquare});
-                }
-            }
-        }
+        addPawnMove(fromSquare, captureSquare, promotion, moves);
     }
 
-    if (board.enPassantSquare != -1)
+    // En passant is checked in full, since it removes a pawn that is not on the target square
+    if (board.enPassantSquare != -1 &&
+        (pawnAttacks(colour, fromSquare) & (1ULL << board.enPassantSquare)) &&
+        isEnPassantLegal(board, fromSquare, colour))
     {
-        int enPassantFile = board.enPassantSquare % BOARD_SIZE;
-        int enPassantRank = board.enPassantSquare / BOARD_SIZE;
-        if (abs(enPassantFile - file) == 1 && enPassantRank == forwardRank)
-        {
-            moves.push_back({rank * BOARD_SIZE + file, board.enPassantSquare});
-        }
+        moves.push_back({fromSquare, board.enPassantSquare, EN_PASSANT});
     }
-
-    return moves;
 }
 
 /**
@@ -114,37 +125,15 @@ std::vector<Move> generatePawnMoves(int rank, int file, Colour colour, const Boa
  * @param file The file of the knight.
  * @param colour The colour of the knight.
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the knight.
+ * @param targetMask The squares the knight may move to without exposing its king.
+ * @param moves The list the knight's moves are appended to.
  */
-std::vector<Move> generateKnightMoves(int rank, int file, Colour colour, const Board &board)
+void generateKnightMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves)
 {
+    int fromSquare = rank * BOARD_SIZE + file;
+    Bitboard friendlyPieces = board.colourPieces[colour];
 
-    std::vector<Move> moves;
-
-    int knightMoves[8][2] = {
-        {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
-
-    Bitboard friendlyPieces = (colour == WHITE) ? board.whitePieces : board.blackPieces;
-
-    for (const auto &move : knightMoves)
-    {
-        int newRank = rank + move[0];
-        int newFile = file + move[1];
-
-        if (newRank >= 0 && newRank < BOARD_SIZE && newFile >= 0 && newFile < BOARD_SIZE)
-        {
-            int toSquare = newRank * BOARD_SIZE + newFile;
-
-            if (friendlyPieces & (1ULL << toSquare))
-            {
-                continue;
-            }
-
-            moves.push_back({rank * BOARD_SIZE + file, toSquare});
-        }
-    }
-
-    return moves;
+    addMoves(fromSquare, knightAttacks(fromSquare) & ~friendlyPieces & targetMask, moves);
 }
 
 /**
@@ -154,53 +143,15 @@ std::vector<Move> generateKnightMoves(int rank, int file, Colour colour, const B
  * @param file The file of the bishop.
  * @param colour The colour of the bishop.
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the bishop.
+ * @param targetMask The squares the bishop may move to without exposing its king.
+ * @param moves The list the bishop's moves are appended to.
  */
-std::vector<Move> generateBishopMoves(int rank, int file, Colour colour, const Board &board)
+void generateBishopMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves)
 {
+    int fromSquare = rank * BOARD_SIZE + file;
+    Bitboard friendlyPieces = board.colourPieces[colour];
 
-    std::vector<Move> moves;
-
-    int directions[4][2] = {
-        {1, 1},
-        {1, -1},
-        {-1, 1},
-        {-1, -1}};
-
-    Bitboard friendlyPieces = (colour == WHITE) ? board.whitePieces : board.blackPieces;
-
-    for (const auto &direction : directions)
-    {
-        int newRank = rank;
-        int newFile = file;
-
-        while (true)
-        {
-            newRank += direction[0];
-            newFile += direction[1];
-
-            if (newRank < 0 || newRank >= BOARD_SIZE || newFile < 0 || newFile >= BOARD_SIZE)
-            {
-                break;
-            }
-
-            int toSquare = newRank * BOARD_SIZE + newFile;
-
-            if (friendlyPieces & (1ULL << toSquare))
-            {
-                break;
-            }
-
-            moves.push_back({rank * BOARD_SIZE + file, toSquare});
-
-            if (board.allPieces & (1ULL << toSquare))
-            {
-                break;
-            }
-        }
-    }
-
-    return moves;
+    addMoves(fromSquare, bishopAttacks(fromSquare, board.allPieces) & ~friendlyPieces & targetMask, moves);
 }
 
 /**
@@ -210,53 +161,15 @@ std::vector<Move> generateBishopMoves(int rank, int file, Colour colour, const B
  * @param file The file of the rook.
  * @param colour The colour of the rook.
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the rook.
+ * @param targetMask The squares the rook may move to without exposing its king.
+ * @param moves The list the rook's moves are appended to.
  */
-std::vector<Move> generateRookMoves(int rank, int file, Colour colour, const Board &board)
+void generateRookMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves)
 {
+    int fromSquare = rank * BOARD_SIZE + file;
+    Bitboard friendlyPieces = board.colourPieces[colour];
 
-    std::vector<Move> moves;
-
-    int directions[4][2] = {
-        {1, 0},
-        {-1, 0},
-        {0, 1},
-        {0, -1}};
-
-    Bitboard friendlyPieces = (colour == WHITE) ? board.whitePieces : board.blackPieces;
-
-    for (const auto &direction : directions)
-    {
-        int newRank = rank;
-        int newFile = file;
-
-        while (true)
-        {
-            newRank += direction[0];
-            newFile += direction[1];
-
-            if (newRank < 0 || newRank >= BOARD_SIZE || newFile < 0 || newFile >= BOARD_SIZE)
-            {
-                break;
-            }
-
-            int toSquare = newRank * BOARD_SIZE + newFile;
-
-            if (friendlyPieces & (1ULL << toSquare))
-            {
-                break;
-            }
-
-            moves.push_back({rank * BOARD_SIZE + file, toSquare});
-
-            if (board.allPieces & (1ULL << toSquare))
-            {
-                break;
-            }
-        }
-    }
-
-    return moves;
+    addMoves(fromSquare, rookAttacks(fromSquare, board.allPieces) & ~friendlyPieces & targetMask, moves);
 }
 
 /**
@@ -266,131 +179,127 @@ std::vector<Move> generateRookMoves(int rank, int file, Colour colour, const Boa
  * @param file The file of the queen.
  * @param colour The colour of the queen.
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the queen.
+ * @param targetMask The squares the queen may move to without exposing its king.
+ * @param moves The list the queen's moves are appended to.
  */
-std::vector<Move> generateQueenMoves(int rank, int file, Colour colour, const Board &board)
+void generateQueenMoves(int rank, int file, Colour colour, const Board &board, Bitboard targetMask, MoveList &moves)
 {
+    int fromSquare = rank * BOARD_SIZE + file;
+    Bitboard friendlyPieces = board.colourPieces[colour];
 
-    std::vector<Move> moves;
-
-    auto rookMoves = generateRookMoves(rank, file, colour, board);
-    moves.insert(moves.end(), rookMoves.begin(), rookMoves.end());
-
-    auto bishopMoves = generateBishopMoves(rank, file, colour, board);
-    moves.insert(moves.end(), bishopMoves.begin(), bishopMoves.end());
-
-    return moves;
+    addMoves(fromSquare, queenAttacks(fromSquare, board.allPieces) & ~friendlyPieces & targetMask, moves);
 }
 
 /**
  * @brief Generates legal moves for a king.
  *
+ * Each destination is tested with the king removed from the board, so the king
+ * cannot step backwards along the line of a slider that is checking it.
+ *
  * @param rank The rank of the king.
  * @param file The file of the king.
  * @param colour The colour of the king.
  * @param board The current state of the board.
- * @return std::vector<Move> A vector of legal moves for the king.
+ * @param moves The list the king's moves are appended to.
  */
-std::vector<Move> generateKingMoves(int rank, int file, Colour colour, const Board &board)
+void generateKingMoves(int rank, int file, Colour colour, const Board &board, MoveList &moves)
 {
+    int fromSquare = rank * BOARD_SIZE + file;
+    Bitboard friendlyPieces = board.colourPieces[colour];
+    Bitboard enemyPieces = board.colourPieces[!colour];
+    Bitboard occupancy = board.allPieces & ~(1ULL << fromSquare);
+    Bitboard targets = kingAttacks(fromSquare) & ~friendlyPieces;
 
-    std::vector<Move> moves;
-
-    int kingMoves[8][2] = {
-        {1, 0},
-        {-1, 0},
-        {0, 1},
-        {0, -1},
-        {1, 1},
-        {1, -1},
-        {-1, 1},
-        {-1, -1}};
-
-    Bitboard friendlyPieces = (colour == WHITE) ? board.whitePieces : board.blackPieces;
-    Colour attacker = (colour == WHITE) ? BLACK : WHITE;
-
-    for (const auto &move : kingMoves)
+    while (targets)
     {
-        int newRank = rank + move[0];
-        int newFile = file + move[1];
+        int toSquare = __builtin_ctzll(targets);
+        targets &= targets - 1;
 
-        if (newRank >= 0 && newRank < BOARD_SIZE && newFile >= 0 && newFile < BOARD_SIZE)
+        if (!(board.attackersTo(toSquare, occupancy) & enemyPieces))
         {
-            int toSquare = newRank * BOARD_SIZE + newFile;
-
-            if (!(friendlyPieces & (1ULL << toSquare)))
-            {
-                if (!isSquareAttacked(toSquare, attacker, board))
-                {
-                    moves.push_back({rank * BOARD_SIZE + file, toSquare});
-                }
-            }
+            moves.push_back({fromSquare, toSquare});
         }
     }
 
     if (colour == WHITE)
     {
-        if (board.whiteCanCastleKingSide &&
+        if ((board.castlingRights & WHITE_KINGSIDE) &&
             !(board.allPieces & ((1ULL << 5) | (1ULL << 6))) &&
-            (board.bitboards[ROOK][WHITE] & (1ULL << 0)) &&
+            (board.bitboards[WHITE][ROOK] & (1ULL << 7)) &&
             !isSquareAttacked(4, BLACK, board) &&
             !isSquareAttacked(5, BLACK, board) &&
             !isSquareAttacked(6, BLACK, board))
         {
-            moves.push_back({4, 6, -1, true});
+            moves.push_back({4, 6, CASTLING});
         }
 
-        if (board.whiteCanCastleQueenSide &&
+        if ((board.castlingRights & WHITE_QUEENSIDE) &&
             !(board.allPieces & ((1ULL << 1) | (1ULL << 2) | (1ULL << 3))) &&
-            (board.bitboards[ROOK][WHITE] & (1ULL << 7)) &&
+            (board.bitboards[WHITE][ROOK] & (1ULL << 0)) &&
             !isSquareAttacked(4, BLACK, board) &&
             !isSquareAttacked(3, BLACK, board) &&
             !isSquareAttacked(2, BLACK, board))
         {
-            moves.push_back({4, 2, -1, true});
+            moves.push_back({4, 2, CASTLING});
         }
     }
     else
     {
-        if (board.blackCanCastleKingSide &&
+        if ((board.castlingRights & BLACK_KINGSIDE) &&
             !(board.allPieces & ((1ULL << 61) | (1ULL << 62))) &&
-            (board.bitboards[ROOK][BLACK] & (1ULL << 63)) &&
+            (board.bitboards[BLACK][ROOK] & (1ULL << 63)) &&
             !isSquareAttacked(60, WHITE, board) &&
             !isSquareAttacked(61, WHITE, board) &&
             !isSquareAttacked(62, WHITE, board))
         {
-            moves.push_back({60, 62, -1, true});
+            moves.push_back({60, 62, CASTLING});
         }
 
-        if (board.blackCanCastleQueenSide &&
+        if ((board.castlingRights & BLACK_QUEENSIDE) &&
             !(board.allPieces & ((1ULL << 57) | (1ULL << 58) | (1ULL << 59))) &&
-            (board.bitboards[ROOK][BLACK] & (1ULL << 56)) &&
+            (board.bitboards[BLACK][ROOK] & (1ULL << 56)) &&
             !isSquareAttacked(60, WHITE, board) &&
             !isSquareAttacked(59, WHITE, board) &&
             !isSquareAttacked(58, WHITE, board))
         {
-            moves.push_back({60, 58, -1, true});
+            moves.push_back({60, 58, CASTLING});
         }
     }
-
-    return moves;
 }
 
 /**
  * @brief Generates all move for a player.
  *
- * @param board The current state of the board.
+ * In double check only the king can move. In single check the other pieces
+ * may only capture the checker or block between it and the king.
+ *
  * @param colour The colour of the player.
- * @return std::vector<Move>
+ * @param board The current state of the board.
+ * @param moves The list the player's legal moves are appended to.
  */
-std::vector<Move> generateMoves(Colour colour, const Board &board)
+void generateMoves(Colour colour, const Board &board, MoveList &moves)
 {
-    std::vector<Move> moves;
-    std::vector<Move> pieceMoves;
+    Bitboard enemyPieces = board.colourPieces[!colour];
+    int king = board.kingSquare(colour);
+    Bitboard checkers = board.attackersTo(king, board.allPieces) & enemyPieces;
+
+    if (checkers & (checkers - 1))
+    {
+        generateKingMoves(king / BOARD_SIZE, king % BOARD_SIZE, colour, board, moves);
+        return;
+    }
 
-    for (int piece = PAWN; piece < MAX_PIECE_TYPE; ++piece)
+    Bitboard targetMask = ~0ULL;
+    if (checkers)
     {
-        Bitboard pieceBB = board.bitboards[piece][colour];
+        targetMask = betweenBB(king, __builtin_ctzll(checkers)) | checkers;
+    }
+
+    Bitboard pinned = pinnedPieces(board, colour);
+
+    for (int piece = PAWN; piece < KING; ++piece)
+    {
+        Bitboard pieceBB = board.bitboards[colour][piece];
 
         while (pieceBB)
         {
@@ -400,33 +309,33 @@ std::vector<Move> generateMoves(Colour colour, const Board &board)
             int rank = square / 8;
             int file = square % 8;
 
+            // A pinned piece can only move along the line between its king and the pinner
+            Bitboard pieceMask = targetMask;
+            if (pinned & (1ULL << square))
+            {
+                pieceMask &= lineBB(king, square);
+            }
+
             switch (piece)
             {
             case PAWN:
-                pieceMoves = generatePawnMoves(rank, file, colour, board);
+                generatePawnMoves(rank, file, colour, board, pieceMask, moves);
                 break;
             case KNIGHT:
-                pieceMoves = generateKnightMoves(rank, file, colour, board);
+                generateKnightMoves(rank, file, colour, board, pieceMask, moves);
                 break;
             case BISHOP:
-                pieceMoves = generateBishopMoves(rank, file, colour, board);
+                generateBishopMoves(rank, file, colour, board, pieceMask, moves);
                 break;
             case ROOK:
-                pieceMoves = generateRookMoves(rank, file, colour, board);
+                generateRookMoves(rank, file, colour, board, pieceMask, moves);
                 break;
             case QUEEN:
-                pieceMoves = generateQueenMoves(rank, file, colour, board);
-                break;
-            case KING:
-                pieceMoves = generateKingMoves(rank, file, colour, board);
+                generateQueenMoves(rank, file, colour, board, pieceMask, moves);
                 break;
             }
-
-            moves.insert(moves.end(), pieceMoves.begin(), pieceMoves.end());
         }
     }
 
-    filterIllegalMoves(moves, board, colour);
-
-    return moves;
+    generateKingMoves(king / BOARD_SIZE, king % BOARD_SIZE, colour, board, moves);
 }
@@ -0,0 +1,191 @@
+/**
+ * @file moveOrdering.cpp
+ * @author Seán Rourke
+ * @brief Implements moveOrdering.h to search the most promising moves first.
+ * @date 2025
+ *
+ * Moves are scored in bands so that every move in a higher band is searched
+ * before any move in a lower one:
+ *
+ *   transposition table move
+ *   captures that do not lose material, and queen promotions (MVV-LVA)
+ *   first killer, second killer
+ *   quiet moves (history score, below the killers)
+ *   captures that lose material by static exchange (MVV-LVA)
+ *   underpromotions
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <utility>
+#include "moveOrdering.h"
+#include "see.h"
+
+namespace
+{
+    const int TT_MOVE_SCORE = 1 << 30;
+    const int CAPTURE_SCORE = 1 << 24;
+    const int FIRST_KILLER_SCORE = 1 << 23;
+    const int SECOND_KILLER_SCORE = FIRST_KILLER_SCORE - 1;
+    const int LOSING_CAPTURE_SCORE = -(1 << 20);
+    const int UNDERPROMOTION_SCORE = -(1 << 24);
+
+    /**
+     * @brief Scores a move for ordering.
+     *
+     * @param board The current state of the chessboard.
+     * @param move The move to score.
+     * @param ttMove The best move stored in the transposition table.
+     * @param heuristics The killer moves and history scores of the current search.
+     * @param ply The distance from the root.
+     * @return int The ordering score, higher first.
+     */
+    int scoreMove(const Board &board, const Move &move, const Move &ttMove, const SearchHeuristics &heuristics, int ply)
+    {
+        if (move == ttMove)
+        {
+            return TT_MOVE_SCORE;
+        }
+
+        Piece attacker = board.pieceOn(move.from());
+        Piece victim = move.enPassant() ? PAWN : board.pieceOn(move.to());
+
+        if (move.isPromotion() && move.promotionPiece() != QUEEN)
+        {
+            return UNDERPROMOTION_SCORE;
+        }
+
+        if (victim != EMPTY || move.isPromotion())
+        {
+            // Most valuable victim first, then least valuable attacker
+            int score = CAPTURE_SCORE - attacker;
+            if (victim != EMPTY)
+                score += 16 * (victim + 1);
+            if (move.isPromotion())
+                score += 16 * QUEEN;
+
+            // Captures that lose material go after the quiet moves
+            if (staticExchange(board, move) < 0)
+                score += LOSING_CAPTURE_SCORE - CAPTURE_SCORE;
+            return score;
+        }
+
+        if (move == heuristics.killers[ply][0])
+        {
+            return FIRST_KILLER_SCORE;
+        }
+        if (move == heuristics.killers[ply][1])
+        {
+            return SECOND_KILLER_SCORE;
+        }
+
+        return heuristics.history[board.currentColour][move.from()][move.to()];
+    }
+}
+
+/**
+ * @brief Forgets all killer moves and history scores.
+ */
+void SearchHeuristics::clear()
+{
+    for (auto &plyKillers : killers)
+    {
+        plyKillers.fill(Move());
+    }
+    for (auto &colourHistory : history)
+    {
+        for (auto &fromHistory : colourHistory)
+        {
+            fromHistory.fill(0);
+        }
+    }
+}
+
+/**
+ * @brief Records a quiet move that caused a beta cutoff.
+ *
+ * The move becomes the first killer for its ply and its history score grows
+ * by the square of the remaining depth. When a score passes HISTORY_MAX every
+ * score for that side is halved, which keeps them below the killer band and
+ * lets newer cutoffs outweigh old ones.
+ *
+ * @param colour The side that made the move.
+ * @param move The move that caused the cutoff.
+ * @param ply The distance from the root.
+ * @param depth The remaining depth of the search that cut off.
+ */
+void SearchHeuristics::updateQuietCutoff(Colour colour, const Move &move, int ply, int depth)
+{
+    if (ply < MAX_PLY && killers[ply][0] != move)
+    {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int &score = history[colour][move.from()][move.to()];
+    score += depth * depth;
+
+    if (score > HISTORY_MAX)
+    {
+        for (auto &fromHistory : history[colour])
+        {
+            for (int &value : fromHistory)
+            {
+                value /= 2;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Construct a new Move Picker object.
+ *
+ * @param board The current state of the chessboard.
+ * @param moves The legal moves to order. Reordered in place as moves are picked.
+ * @param ttMove The best move stored in the transposition table (the null move if none).
+ * @param heuristics The killer moves and history scores of the current search.
+ * @param ply The distance from the root.
+ */
+MovePicker::MovePicker(const Board &board, MoveList &moves, const Move &ttMove, const SearchHeuristics &heuristics, int ply)
+    : moves(moves)
+{
+    ply = std::min(ply, MAX_PLY - 1);
+    for (int i = 0; i < moves.size(); ++i)
+    {
+        scores[i] = scoreMove(board, moves[i], ttMove, heuristics, ply);
+    }
+}
+
+/**
+ * @brief Gives the best move not yet picked.
+ *
+ * Uses one pass of a selection sort, so a node that cuts off early never
+ * pays to sort the moves it does not search.
+ *
+ * @param move Set to the next move.
+ * @return true If a move was picked.
+ * @return false If every move has been picked.
+ */
+bool MovePicker::next(Move &move)
+{
+    if (picked >= moves.size())
+    {
+        return false;
+    }
+
+    int best = picked;
+    for (int i = picked + 1; i < moves.size(); ++i)
+    {
+        if (scores[i] > scores[best])
+        {
+            best = i;
+        }
+    }
+
+    std::swap(moves[picked], moves[best]);
+    std::swap(scores[picked], scores[best]);
+    move = moves[picked++];
+    return true;
+}
@@ -5,196 +5,103 @@
  * @date 2025
  *
  * Provides functionality to check if a square is attacked, used in both
- * castling and pin logic.
+ * castling and king safety, and to find pinned pieces for legal move generation.
  *
  * @copyright Copyright (c) 2025
  *
  */
 
 #include "moveValidation.h"
-#include "vector"
-#include "move.h"
-#include "moveGeneration.h"
-#include "makeMove.h"
+#include "attacks.h"
 
+/**
+ * @brief Checks if a square is attacked by any piece of the given colour.
+ *
+ * @param square The square being checked for attacks.
+ * @param attacker The colour of the attacking player.
+ * @param board The current state of the chessboard.
+ * @return true If the square is attacked.
+ * @return false If the square is not attacked.
+ */
 bool isSquareAttacked(int square, Colour attacker, const Board &board)
 {
-    Colour defender = (attacker == WHITE) ? BLACK : WHITE;
-
-    // Check for pawn attacks
-    if (defender == WHITE)
-    {
-        if (square % 8 != 0)
-        {
-            int left = square + 7;
-            if (board.blackPieces & (1ULL << left) && board.pieces[left] == PAWN)
-            {
-                return true;
-            }
-        }
-        if (square % 8 != 7)
-        {
-            int right = square + 9;
-            if (board.blackPieces & (1ULL << right) && board.pieces[right] == PAWN)
-            {
-                return true;
-            }
-        }
-    }
-
-    if (defender == BLACK)
-    {
-        if (square % 8 != 0)
-        {
-            int left = square - 7;
-            if (board.whitePieces & (1ULL << left) && board.pieces[left] == PAWN)
-            {
-                return true;
-            }
-        }
-        if (square % 8 != 7)
-        {
-            int right = square - 9;
-            if (board.whitePieces & (1ULL << right) && board.pieces[right] == PAWN)
-            {
-                return true;
-            }
-        }
-    }
+    Bitboard attackerPieces = board.colourPieces[attacker];
+    return board.attackersTo(square, board.allPieces) & attackerPieces;
+}
 
-    // Check for knight attacks
-    int knightMoves[8][2] = {
-        {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2}};
+/**
+ * @brief Checks if a player's king is in check.
+ *
+ * @param board The current state of the chessboard.
+ * @param colour The player whose king is checked.
+ * @return true If the king is attacked.
+ * @return false If the king is safe.
+ */
+bool isInCheck(const Board &board, Colour colour)
+{
+    Colour opponent = (colour == WHITE) ? BLACK : WHITE;
+    return isSquareAttacked(board.kingSquare(colour), opponent, board);
+}
 
-    for (const auto &move : knightMoves)
-    {
-        int newRank = square / BOARD_SIZE + move[0];
-        int newFile = square % BOARD_SIZE + move[1];
-        if (newRank >= 0 && newRank < BOARD_SIZE && newFile >= 0 && newFile < BOARD_SIZE)
-        {
-            int knightSquare = newRank * BOARD_SIZE + newFile;
-            if (board.allPieces & (1ULL << knightSquare) &&
-                ((defender == WHITE && board.blackPieces & (1ULL << knightSquare) && board.pieces[knightSquare] == KNIGHT) ||
-                 (defender == BLACK && board.whitePieces & (1ULL << knightSquare) && board.pieces[knightSquare] == KNIGHT)))
-            {
-                return true; // Attacked by a knight
-            }
-        }
-    }
+/**
+ * @brief Finds the pieces of a player that are pinned to their own king.
+ *
+ * Looks along every rank, file and diagonal from the king for enemy sliders
+ * that would attack it on an otherwise empty board. If exactly one piece sits
+ * between such a slider and the king, and it belongs to the player, it is pinned.
+ *
+ * @param board The current state of the chessboard.
+ * @param colour The player whose pinned pieces are found.
+ * @return Bitboard The squares of the pinned pieces.
+ */
+Bitboard pinnedPieces(const Board &board, Colour colour)
+{
+    Colour opponent = (colour == WHITE) ? BLACK : WHITE;
+    Bitboard friendlyPieces = board.colourPieces[colour];
+    int king = board.kingSquare(colour);
 
-    // Check for bishop and queen attacks (diagonal)
-    int directionsBishop[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-    for (const auto &direction : directionsBishop)
-    {
-        int newRank = square / BOARD_SIZE;
-        int newFile = square % BOARD_SIZE;
-        while (true)
-        {
-            newRank += direction[0];
-            newFile += direction[1];
-            if (newRank < 0 || newRank >= BOARD_SIZE || newFile < 0 || newFile >= BOARD_SIZE)
-            {
-                break; // Out of bounds
-            }
-            int newSquare = newRank * BOARD_SIZE + newFile;
-            if (board.allPieces & (1ULL << newSquare))
-            {
-                // If a piece is found, check its type
-                if ((defender == WHITE && board.blackPieces & (1ULL << newSquare)) ||
-                    (defender == BLACK && board.whitePieces & (1ULL << newSquare)))
-                {
-                    if (board.pieces[newSquare] == BISHOP || board.pieces[newSquare] == QUEEN)
-                    {
-                        return true; // Attacked by a bishop or queen
-                    }
-                }
-                break; // Stop if a piece is blocking the path
-            }
-        }
-    }
+    Bitboard queens = board.bitboards[opponent][QUEEN];
+    Bitboard snipers = (rookAttacks(king, 0) & (board.bitboards[opponent][ROOK] | queens)) |
+                       (bishopAttacks(king, 0) & (board.bitboards[opponent][BISHOP] | queens));
 
-    // Check for rook and queen attacks (straight)
-    int directionsRook[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
-    for (const auto &direction : directionsRook)
+    Bitboard pinned = 0;
+    while (snipers)
     {
-        int newRank = square / BOARD_SIZE;
-        int newFile = square % BOARD_SIZE;
-        while (true)
-        {
-            newRank += direction[0];
-            newFile += direction[1];
-            if (newRank < 0 || newRank >= BOARD_SIZE || newFile < 0 || newFile >= BOARD_SIZE)
-            {
-                break; // Out of bounds
-            }
-            int newSquare = newRank * BOARD_SIZE + newFile;
-            if (board.allPieces & (1ULL << newSquare))
-            {
-                // If a piece is found, check its type
-                if ((defender == WHITE && board.blackPieces & (1ULL << newSquare)) ||
-                    (defender == BLACK && board.whitePieces & (1ULL << newSquare)))
-                {
-                    if (board.pieces[newSquare] == ROOK || board.pieces[newSquare] == QUEEN)
-                    {
-                        return true; // Attacked by a rook or queen
-                    }
-                }
-                break; // Stop if a piece is blocking the path
-            }
-        }
-    }
+        int sniper = __builtin_ctzll(snipers);
+        snipers &= snipers - 1;
 
-    // Check for king attacks (adjacent squares)
-    int kingMoves[8][2] = {
-        {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
-    for (const auto &move : kingMoves)
-    {
-        int newRank = square / BOARD_SIZE + move[0];
-        int newFile = square % BOARD_SIZE + move[1];
-        if (newRank >= 0 && newRank < BOARD_SIZE && newFile >= 0 && newFile < BOARD_SIZE)
+        Bitboard blockers = betweenBB(king, sniper) & board.allPieces;
+        if (blockers && !(blockers & (blockers - 1)) && (blockers & friendlyPieces))
         {
-            int kingSquare = newRank * BOARD_SIZE + newFile;
-            if (board.allPieces & (1ULL << kingSquare) &&
-                ((defender == WHITE && board.blackPieces & (1ULL << kingSquare) && board.pieces[kingSquare] == KING) ||
-                 (defender == BLACK && board.whitePieces & (1ULL << kingSquare) && board.pieces[kingSquare] == KING)))
-            {
-                return true; // Attacked by a king
-            }
+            pinned |= blockers;
         }
     }
 
-    return false; // Not attacked
+    return pinned;
 }
 
 /**
- * @brief Filters out moves that would leave the moving player's king in check.
+ * @brief Checks if an en passant capture leaves the moving player's king safe.
  *
- * @param moves Unfiltered generated moves.
- * @param board The current state of the chessboard.
- * @param colour The player making the move.
+ * En passant removes two pieces from the capturing pawn's path at once, so it
+ * can expose the king along the rank in a way pin detection does not see. The
+ * occupancy after the capture is built directly and the king tested against it.
  *
- * This function creates a copy of the main board.
- * It then simulates each potential move and checks if it leaves the moving player's king in check.
- * If it does, the move is removed from the movelist.
+ * @param board The current state of the chessboard.
+ * @param from The square of the capturing pawn.
+ * @param colour The player making the capture.
+ * @return true If the capture is legal.
+ * @return false If the capture would leave the king in check.
  */
-void filterIllegalMoves(std::vector<Move> &moves, const Board &board, Colour colour)
+bool isEnPassantLegal(const Board &board, int from, Colour colour)
 {
+    int to = board.enPassantSquare;
+    int capturedPawnSquare = to + ((colour == WHITE) ? -8 : 8);
+    Bitboard enemyPieces = board.colourPieces[!colour];
 
-    moves.erase(std::remove_if(moves.begin(), moves.end(),
-                               [&](const Move &move)
-                               {
-                                   Board tempBoard = board; // Copy the board
-                                   makeMove(tempBoard, move);
+    Bitboard occupancy = (board.allPieces ^ (1ULL << from) ^ (1ULL << capturedPawnSquare)) | (1ULL << to);
+    Bitboard attackers = board.attackersTo(board.kingSquare(colour), occupancy) &
+                         enemyPieces & ~(1ULL << capturedPawnSquare);
 
-                                   Bitboard kingBB = tempBoard.bitboards[KING][colour];
-                                   if (kingBB == 0)
-                                       return true; // If king is missing, move is illegal
-
-                                   // Find the king's position after making the move
-                                   int kingSquare = __builtin_ctzll(kingBB);
-
-                                   // Remove move if it leaves the king in check
-                                   return isSquareAttacked(kingSquare, (colour == WHITE) ? BLACK : WHITE, tempBoard);
-                               }),
-                moves.end());
-}
\ No newline at end of file
+    return attackers == 0;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file pawnStructure.cpp
+ * @author Seán Rourke
+ * @brief This file implements pawnStructure.h.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include "pawnStructure.h"
+#include "attacks.h"
+
+namespace
+{
+    const Bitboard FILE_A = 0x0101010101010101ULL;
+
+    const int DOUBLED_MIDDLEGAME = -15;  ///< Penalty for each pawn with another of its side in front of it.
+    const int DOUBLED_ENDGAME = -25;
+    const int ISOLATED_MIDDLEGAME = -15; ///< Penalty for a pawn with no pawn of its side on a neighbouring file.
+    const int ISOLATED_ENDGAME = -20;
+    const int BACKWARD_MIDDLEGAME = -10; ///< Penalty for a pawn left behind whose advance is guarded by an enemy pawn.
+    const int BACKWARD_ENDGAME = -10;
+
+    const int passedMiddlegame[BOARD_SIZE] = {0, 5, 10, 20, 35, 60, 100, 0}; ///< Passed pawn bonus by rank from its own side.
+    const int passedEndgame[BOARD_SIZE] = {0, 10, 20, 35, 60, 100, 150, 0};
+
+    const int SHIELD_NEAR = 20; ///< Bonus for a pawn directly in front of the king's files.
+    const int SHIELD_FAR = 10;  ///< Bonus for a shield pawn that has advanced one square.
+
+    Bitboard fileMask(int file)
+    {
+        return FILE_A << file;
+    }
+
+    Bitboard adjacentFiles(int file)
+    {
+        return ((file > 0) ? fileMask(file - 1) : 0) | ((file < BOARD_SIZE - 1) ? fileMask(file + 1) : 0);
+    }
+
+    /**
+     * @brief Gives every square on the ranks in front of a rank, from one side's point of view.
+     *
+     * @param colour The side moving up the board.
+     * @param rank The rank, from 0 (rank 1) to 7 (rank 8).
+     * @return Bitboard The squares on the ranks ahead.
+     */
+    Bitboard ranksAhead(Colour colour, int rank)
+    {
+        if (colour == WHITE)
+            return (rank == BOARD_SIZE - 1) ? 0 : ~0ULL << (BOARD_SIZE * (rank + 1));
+        return (rank == 0) ? 0 : ~0ULL >> (BOARD_SIZE * (BOARD_SIZE - rank));
+    }
+
+    /**
+     * @brief Scores one side's pawns.
+     *
+     * @param board The current state of the chessboard.
+     * @param colour The side to score.
+     * @param middlegame Increased by the middlegame score of the side's pawns.
+     * @param endgame Increased by the endgame score of the side's pawns.
+     */
+    void evaluateSide(const Board &board, Colour colour, int &middlegame, int &endgame)
+    {
+        Colour opponent = (colour == WHITE) ? BLACK : WHITE;
+        Bitboard own = board.bitboards[colour][PAWN];
+        Bitboard enemy = board.bitboards[opponent][PAWN];
+
+        Bitboard pawns = own;
+        while (pawns)
+        {
+            int square = __builtin_ctzll(pawns);
+            pawns &= pawns - 1;
+
+            int file = square % BOARD_SIZE;
+            int rank = square / BOARD_SIZE;
+            int relativeRank = (colour == WHITE) ? rank : BOARD_SIZE - 1 - rank;
+            Bitboard ahead = ranksAhead(colour, rank);
+            Bitboard neighbours = adjacentFiles(file);
+
+            // Every pawn but the most advanced on a file counts as doubled
+            if (own & fileMask(file) & ahead)
+            {
+                middlegame += DOUBLED_MIDDLEGAME;
+                endgame += DOUBLED_ENDGAME;
+            }
+
+            bool isolated = !(own & neighbours);
+            if (isolated)
+            {
+                middlegame += ISOLATED_MIDDLEGAME;
+                endgame += ISOLATED_ENDGAME;
+            }
+
+            if (!(enemy & (fileMask(file) | neighbours) & ahead))
+            {
+                middlegame += passedMiddlegame[relativeRank];
+                endgame += passedEndgame[relativeRank];
+            }
+            else if (!isolated && !(own & neighbours & ~ahead))
+            {
+                // No pawn beside or behind can defend it, and an enemy pawn guards its next square
+                int stopSquare = square + ((colour == WHITE) ? BOARD_SIZE : -BOARD_SIZE);
+                if (pawnAttackTable[colour][stopSquare] & enemy)
+                {
+                    middlegame += BACKWARD_MIDDLEGAME;
+                    endgame += BACKWARD_ENDGAME;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gives the bonus for the pawns in front of a king on its back rank.
+ *
+ * For each of the king's file and its neighbours, a pawn one rank ahead of
+ * the king earns the full bonus and a pawn two ranks ahead half of it.
+ * Worked out again only when the king has moved since the last call.
+ *
+ * @param board The current state of the chessboard, with this entry's pawns.
+ * @param colour The side whose king is sheltered.
+ * @return Score The shield bonus for that side (never negative).
+ */
+Score PawnEntry::shield(const Board &board, Colour colour)
+{
+    int kingSquare = board.kingSquare(colour);
+    if (shieldKingSquare[colour] == kingSquare)
+    {
+        return shieldScore[colour];
+    }
+
+    int score = 0;
+    int backRank = (colour == WHITE) ? 0 : BOARD_SIZE - 1;
+    int forward = (colour == WHITE) ? BOARD_SIZE : -BOARD_SIZE;
+    Bitboard pawns = board.bitboards[colour][PAWN];
+
+    if (kingSquare / BOARD_SIZE == backRank)
+    {
+        int kingFile = kingSquare % BOARD_SIZE;
+        for (int file = std::max(0, kingFile - 1); file <= std::min(BOARD_SIZE - 1, kingFile + 1); ++file)
+        {
+            int near = backRank * BOARD_SIZE + file + forward;
+            if (pawns & (1ULL << near))
+                score += SHIELD_NEAR;
+            else if (pawns & (1ULL << (near + forward)))
+                score += SHIELD_FAR;
+        }
+    }
+
+    shieldKingSquare[colour] = static_cast<int8_t>(kingSquare);
+    shieldScore[colour] = static_cast<int16_t>(score);
+    return score;
+}
+
+/**
+ * @brief Evaluates a pawn structure from scratch.
+ *
+ * Penalises doubled, isolated and backward pawns and rewards passed pawns
+ * more the further they have advanced.
+ *
+ * @param board The current state of the chessboard.
+ * @param entry Filled in with the pawn key and scores. The shield is reset.
+ */
+void evaluatePawns(const Board &board, PawnEntry &entry)
+{
+    int whiteMiddlegame = 0, whiteEndgame = 0;
+    int blackMiddlegame = 0, blackEndgame = 0;
+
+    entry.key = board.pawnKey;
+    evaluateSide(board, WHITE, whiteMiddlegame, whiteEndgame);
+    evaluateSide(board, BLACK, blackMiddlegame, blackEndgame);
+    entry.middlegame = static_cast<int16_t>(whiteMiddlegame - blackMiddlegame);
+    entry.endgame = static_cast<int16_t>(whiteEndgame - blackEndgame);
+    entry.shieldKingSquare = {-1, -1};
+}
+
+/**
+ * @brief Construct a new Pawn Table object with every entry empty.
+ *
+ * An empty entry has key 0 and zero scores, which is also the correct
+ * evaluation of a position without pawns, so no separate valid flag is needed.
+ */
+PawnTable::PawnTable() : entries(new PawnEntry[SIZE])
+{
+}
+
+/**
+ * @brief Finds the entry for the board's pawn structure, evaluating it on a miss.
+ *
+ * @param board The current state of the chessboard.
+ * @return PawnEntry& The entry, valid until the next probe.
+ */
+PawnEntry &PawnTable::probe(const Board &board)
+{
+    PawnEntry &entry = entries[board.pawnKey & (SIZE - 1)];
+    if (entry.key != board.pawnKey)
+    {
+        evaluatePawns(board, entry);
+    }
+    return entry;
+}
+
+/**
+ * @brief Empties every entry, for a new game.
+ */
+void PawnTable::clear()
+{
+    std::fill(entries.get(), entries.get() + SIZE, PawnEntry());
+}
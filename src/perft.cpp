@@ -0,0 +1,290 @@
+/**
+ * @file perft.cpp
+ * @author Seán Rourke
+ * @brief Implements perft.h to count move generation tree nodes.
+ * @date 2025
+ *
+ * Perft walks every legal move to a fixed depth and counts the leaves. The
+ * counts for well-known positions are published, so any difference points to
+ * a bug in move generation or makeMove/unmakeMove.
+ *
+ * Each PerftTable slot packs the remaining depth and leaf count into one
+ * 64-bit word: bits 0-7 hold the depth and bits 8-63 the count.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "perft.h"
+#include "makeMove.h"
+#include "moveGeneration.h"
+#include "uciConversion.h"
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree to a given depth.
+ *
+ * The generator only produces legal moves, so at the last ply the leaves are
+ * counted from the size of the move list without making them.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param depth The number of plies to count to.
+ * @return uint64_t The number of leaf nodes.
+ */
+uint64_t perft(Board &board, int depth)
+{
+    if (depth == 0)
+    {
+        return 1;
+    }
+
+    MoveList moves;
+    generateMoves(board.currentColour, board, moves);
+
+    if (depth == 1)
+    {
+        return moves.size();
+    }
+
+    uint64_t nodes = 0;
+    for (const Move &move : moves)
+    {
+        MoveHistory history = makeMove(board, move);
+        nodes += perft(board, depth - 1);
+        unmakeMove(board, history);
+    }
+
+    return nodes;
+}
+
+/**
+ * @brief Counts leaf nodes like perft, printing the count below each root move.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param depth The number of plies to count to.
+ * @param out The stream each "move: count" line is written to.
+ * @return uint64_t The total number of leaf nodes.
+ */
+uint64_t perftDivide(Board &board, int depth, std::ostream &out)
+{
+    MoveList moves;
+    generateMoves(board.currentColour, board, moves);
+
+    uint64_t total = 0;
+    for (Move move : moves)
+    {
+        MoveHistory history = makeMove(board, move);
+        uint64_t nodes = (depth > 1) ? perft(board, depth - 1) : 1;
+        unmakeMove(board, history);
+
+        out << convertToUCI(move) << ": " << nodes << '\n';
+        total += nodes;
+    }
+
+    return total;
+}
+
+namespace
+{
+    /**
+     * @brief Mixes the depth into a position key so each depth of a position has its own slot.
+     *
+     * @param key The Zobrist key of the position.
+     * @param depth The remaining depth.
+     * @return uint64_t The key used for the table.
+     */
+    uint64_t depthKey(uint64_t key, int depth)
+    {
+        return key ^ (uint64_t(depth) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    /**
+     * @brief Counts leaf nodes like perft, caching subtree counts in a table.
+     *
+     * @param board The current state of the chessboard, restored before returning.
+     * @param depth The number of plies to count to.
+     * @param table The shared cache of subtree counts.
+     * @return uint64_t The number of leaf nodes.
+     */
+    uint64_t hashedPerft(Board &board, int depth, PerftTable &table)
+    {
+        // Bulk counting makes shallow subtrees cheaper to recount than to look up
+        if (depth <= 2)
+        {
+            return perft(board, depth);
+        }
+
+        uint64_t nodes = 0;
+        if (table.probe(board.hashKey, depth, nodes))
+        {
+            return nodes;
+        }
+
+        MoveList moves;
+        generateMoves(board.currentColour, board, moves);
+
+        for (const Move &move : moves)
+        {
+            MoveHistory history = makeMove(board, move);
+            nodes += hashedPerft(board, depth - 1, table);
+            unmakeMove(board, history);
+        }
+
+        table.store(board.hashKey, depth, nodes);
+        return nodes;
+    }
+
+    /**
+     * @brief Collects every position a number of plies below the current one.
+     *
+     * @param board The current state of the chessboard, restored before returning.
+     * @param plies The number of plies to expand.
+     * @param positions The positions found are appended here.
+     */
+    void collectPositions(Board &board, int plies, std::vector<Board> &positions)
+    {
+        if (plies == 0)
+        {
+            positions.push_back(board);
+            return;
+        }
+
+        MoveList moves;
+        generateMoves(board.currentColour, board, moves);
+
+        for (const Move &move : moves)
+        {
+            MoveHistory history = makeMove(board, move);
+            collectPositions(board, plies - 1, positions);
+            unmakeMove(board, history);
+        }
+    }
+}
+
+/**
+ * @brief Construct a new Perft Table object.
+ *
+ * The slot count is rounded down to a power of two so a key can be mapped to
+ * its slot with a mask.
+ *
+ * @param megabytes The size of the table in megabytes.
+ */
+PerftTable::PerftTable(std::size_t megabytes)
+{
+    std::size_t slotCount = 1;
+    while (slotCount * 2 * sizeof(Slot) <= megabytes * 1024 * 1024)
+    {
+        slotCount *= 2;
+    }
+
+    slots.reset(new Slot[slotCount]);
+    slotMask = slotCount - 1;
+}
+
+/**
+ * @brief Looks up the leaf count of a position at a depth.
+ *
+ * @param key The Zobrist key of the position.
+ * @param depth The remaining depth.
+ * @param nodes Set to the stored leaf count if found.
+ * @return true If the count was found.
+ * @return false If the count was not found.
+ */
+bool PerftTable::probe(uint64_t key, int depth, uint64_t &nodes) const
+{
+    key = depthKey(key, depth);
+    const Slot &slot = slots[key & slotMask];
+
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+
+    if ((keyXorData ^ data) != key || static_cast<int>(data & 0xFF) != depth)
+    {
+        return false;
+    }
+
+    nodes = data >> 8;
+    return true;
+}
+
+/**
+ * @brief Stores the leaf count of a position at a depth.
+ *
+ * The slot is always overwritten; the newest counts are the ones most likely
+ * to be needed again by nearby transpositions.
+ *
+ * @param key The Zobrist key of the position.
+ * @param depth The remaining depth.
+ * @param nodes The leaf count.
+ */
+void PerftTable::store(uint64_t key, int depth, uint64_t nodes)
+{
+    key = depthKey(key, depth);
+    Slot &slot = slots[key & slotMask];
+
+    uint64_t data = (nodes << 8) | (depth & 0xFF);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Counts leaf nodes like perft, splitting the work across several threads.
+ *
+ * Every position splitDepth plies below the root becomes a work item, and the
+ * threads take items from a shared queue until none are left. If a table is
+ * given, subtree counts are cached in it so transposed subtrees are counted
+ * once.
+ *
+ * @param board The position to count from.
+ * @param depth The number of plies to count to.
+ * @param threads The number of worker threads.
+ * @param splitDepth The number of plies expanded before handing work to threads.
+ * @param table Optional shared cache of subtree counts (nullptr for none).
+ * @return uint64_t The number of leaf nodes.
+ */
+uint64_t parallelPerft(const Board &board, int depth, int threads, int splitDepth, PerftTable *table)
+{
+    Board root = board;
+
+    // Leave at least one ply for the workers so the last ply is still bulk counted
+    splitDepth = std::max(0, std::min(splitDepth, depth - 1));
+    if (depth <= 1)
+    {
+        return perft(root, depth);
+    }
+
+    std::vector<Board> positions;
+    collectPositions(root, splitDepth, positions);
+
+    int remainingDepth = depth - splitDepth;
+    std::atomic<std::size_t> nextPosition{0};
+    std::atomic<uint64_t> total{0};
+
+    auto worker = [&]()
+    {
+        uint64_t nodes = 0;
+        std::size_t i;
+        while ((i = nextPosition.fetch_add(1, std::memory_order_relaxed)) < positions.size())
+        {
+            Board &position = positions[i];
+            nodes += table ? hashedPerft(position, remainingDepth, *table) : perft(position, remainingDepth);
+        }
+        total.fetch_add(nodes, std::memory_order_relaxed);
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+    {
+        pool.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+
+    return total.load();
+}
@@ -0,0 +1,107 @@
+/**
+ * @file pieceSquareTables.cpp
+ * @author Seán Rourke
+ * @brief Implements pieceSquareTables.h by generating the tables.
+ * @date 2025
+ *
+ * The tables are built from a few simple rules evaluated at compile time:
+ * minor pieces and the queen want the centre, pawns want to advance, rooks
+ * want the seventh rank, and the king wants shelter in the middlegame but the
+ * centre in the endgame. Black's tables mirror white's with the sign flipped.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "pieceSquareTables.h"
+
+namespace
+{
+    constexpr int middlegameValues[MAX_PIECE_TYPE] = {100, 300, 310, 500, 900, 0}; ///< Material in the middlegame.
+    constexpr int endgameValues[MAX_PIECE_TYPE] = {120, 280, 310, 520, 920, 0};    ///< Material in the endgame.
+
+    /**
+     * @brief Counts the king steps from a square to the nearest of the four centre squares.
+     *
+     * @param square The square, from 0 (a1) to 63 (h8).
+     * @return int 0 in the centre, up to 6 in the corners.
+     */
+    constexpr int centreDistance(int square)
+    {
+        int file = square % BOARD_SIZE;
+        int rank = square / BOARD_SIZE;
+        int fileDistance = (file < 4) ? 3 - file : file - 4;
+        int rankDistance = (rank < 4) ? 3 - rank : rank - 4;
+        return fileDistance + rankDistance;
+    }
+
+    /**
+     * @brief Gives the placement bonus for a white piece on a square.
+     *
+     * @param piece The piece type.
+     * @param square The square, from white's side of the board.
+     * @param endgame Whether to give the endgame rather than the middlegame bonus.
+     * @return int The bonus in centipawns.
+     */
+    constexpr int placement(int piece, int square, bool endgame)
+    {
+        int file = square % BOARD_SIZE;
+        int rank = square / BOARD_SIZE;
+        int distance = centreDistance(square);
+
+        switch (piece)
+        {
+        case PAWN:
+            // Centre pawns are worth more in the middlegame, advanced pawns in the endgame
+            if (endgame)
+                return 10 * (rank - 1);
+            return 5 * (rank - 1) + ((file == 3 || file == 4) && rank >= 3 ? 20 : 0);
+        case KNIGHT:
+            return endgame ? 15 - 6 * distance : 20 - 8 * distance;
+        case BISHOP:
+            // An undeveloped bishop still blocks the back rank
+            return 10 - 4 * distance - (!endgame && rank == 0 ? 15 : 0);
+        case ROOK:
+            return (rank == 6) ? (endgame ? 15 : 20) : 0;
+        case QUEEN:
+            return endgame ? 10 - 4 * distance : 5 - 2 * distance;
+        case KING:
+            if (endgame)
+                return 20 - 8 * distance;
+            if (rank == 0)
+                return (file == 1 || file == 2 || file == 6) ? 20 : 0;
+            return -20 * (rank < 3 ? rank : 3);
+        default:
+            return 0;
+        }
+    }
+
+    /**
+     * @brief Fills both colours' tables for both game phases.
+     *
+     * @return PieceSquareTables The generated tables.
+     */
+    constexpr PieceSquareTables generateTables()
+    {
+        PieceSquareTables tables = {};
+
+        for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
+        {
+            for (int square = 0; square < 64; ++square)
+            {
+                int middlegame = middlegameValues[piece] + placement(piece, square, false);
+                int endgame = endgameValues[piece] + placement(piece, square, true);
+
+                // Black's pieces use the square mirrored top to bottom
+                tables.middlegame[WHITE][piece][square] = static_cast<int16_t>(middlegame);
+                tables.endgame[WHITE][piece][square] = static_cast<int16_t>(endgame);
+                tables.middlegame[BLACK][piece][square ^ 56] = static_cast<int16_t>(-middlegame);
+                tables.endgame[BLACK][piece][square ^ 56] = static_cast<int16_t>(-endgame);
+            }
+        }
+
+        return tables;
+    }
+}
+
+constexpr PieceSquareTables pieceSquareTables = generateTables();
@@ -0,0 +1,177 @@
+/**
+ * @file positionTracker.cpp
+ * @author Seán Rourke
+ * @brief Implements positionTracker.h to keep the board in step with the GUI.
+ * @date 2025
+ *
+ * Commands are tokenized in place with string_views, and the move list is
+ * compared with the previous one as a single block of text, so a command that
+ * adds one move to a long game costs one memory compare and one makeMove.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <stdexcept>
+#include "positionTracker.h"
+#include "makeMove.h"
+#include "moveGeneration.h"
+#include "uciConversion.h"
+
+namespace
+{
+    /**
+     * @brief Removes leading and trailing whitespace.
+     *
+     * @param text The text to trim.
+     * @return std::string_view The trimmed text.
+     */
+    std::string_view trim(std::string_view text)
+    {
+        std::size_t start = text.find_first_not_of(" \t\r\n");
+        if (start == std::string_view::npos)
+        {
+            return std::string_view();
+        }
+        std::size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(start, end - start + 1);
+    }
+
+    /**
+     * @brief Takes the next whitespace separated token from the front of some text.
+     *
+     * @param text The remaining text, advanced past the token.
+     * @return std::string_view The token, or an empty view if none are left.
+     */
+    std::string_view nextToken(std::string_view &text)
+    {
+        std::size_t start = text.find_first_not_of(" \t\r\n");
+        if (start == std::string_view::npos)
+        {
+            text = std::string_view();
+            return text;
+        }
+
+        std::size_t end = text.find_first_of(" \t\r\n", start);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+
+        std::string_view token = text.substr(start, end - start);
+        text.remove_prefix(end);
+        return token;
+    }
+
+    /**
+     * @brief Plays a list of UCI moves on the board, checking each is legal.
+     *
+     * @param board The board to play the moves on.
+     * @param moves The moves in UCI notation, separated by whitespace.
+     * @throws std::invalid_argument If a move is not legal in the position it is played in.
+     */
+    void playMoves(Board &board, std::string_view moves)
+    {
+        MoveList legalMoves;
+
+        for (std::string_view token = nextToken(moves); !token.empty(); token = nextToken(moves))
+        {
+            Move move = convertFromUCI(board, token);
+
+            legalMoves.clear();
+            generateMoves(board.currentColour, board, legalMoves);
+            bool legal = false;
+            for (const Move &legalMove : legalMoves)
+            {
+                legal = legal || legalMove == move;
+            }
+
+            if (!legal)
+            {
+                throw std::invalid_argument("Illegal move in position command: " + std::string(token));
+            }
+
+            makeMove(board, move);
+        }
+    }
+}
+
+/**
+ * @brief Brings the board to the position described by a UCI position command.
+ *
+ * If the starting position matches and the previous move list is a prefix of
+ * the new one, only the extra moves are played. Otherwise the board is loaded
+ * from the starting position and every move is played.
+ *
+ * @param board The board to update.
+ * @param command The full command, starting with "position".
+ * @throws std::invalid_argument If the command, FEN or a move is invalid. The
+ * board and the tracked position are then left as they were.
+ */
+void PositionTracker::update(Board &board, std::string_view command)
+{
+    nextToken(command); // position
+    std::string_view token = nextToken(command);
+
+    std::string newFen;
+    if (token == "startpos")
+    {
+        newFen = START_FEN;
+        token = nextToken(command);
+    }
+    else if (token == "fen")
+    {
+        for (token = nextToken(command); !token.empty() && token != "moves"; token = nextToken(command))
+        {
+            if (!newFen.empty())
+            {
+                newFen += ' ';
+            }
+            newFen.append(token);
+        }
+    }
+    else
+    {
+        throw std::invalid_argument("Expected startpos or fen in position command");
+    }
+
+    std::string_view moves = (token == "moves") ? trim(command) : std::string_view();
+
+    // The old move list must end on a move boundary of the new one
+    std::string_view previous = appliedMoves;
+    bool extendsPrevious = synced && newFen == fen &&
+                           moves.substr(0, previous.size()) == previous &&
+                           (previous.empty() || moves.size() == previous.size() || moves[previous.size()] == ' ');
+
+    // Played on a copy so a bad FEN or move leaves the last good position on the board
+    Board updated = board;
+    std::string_view newMoves = moves;
+    if (extendsPrevious)
+    {
+        newMoves.remove_prefix(previous.size());
+    }
+    else
+    {
+        updated.loadFEN(newFen);
+    }
+    playMoves(updated, newMoves);
+
+    board = updated;
+    if (!extendsPrevious)
+    {
+        fen = newFen;
+        appliedMoves.clear();
+    }
+    appliedMoves.append(newMoves);
+    synced = true;
+}
+
+/**
+ * @brief Forgets the tracked position so the next command rebuilds the board.
+ */
+void PositionTracker::reset()
+{
+    synced = false;
+    fen.clear();
+    appliedMoves.clear();
+}
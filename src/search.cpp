@@ -8,64 +8,1031 @@
  *
  */
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 #include "search.h"
 #include "evaluation.h"
+#include "moveOrdering.h"
 #include "moveGeneration.h"
+#include "moveValidation.h"
+#include "see.h"
+#include "transposition.h"
+#include "uciConversion.h"
+
+SearchParameters searchParameters;
+
+/**
+ * @struct SearchNode
+ * @brief The parts of a node that are needed to search any one of its moves.
+ */
+struct SearchNode
+{
+    int depth;    ///< Remaining depth at the node.
+    int ply;      ///< Distance of the node from the root.
+    Score beta;   ///< Upper bound of the node's window.
+    bool pvNode;  ///< Whether the node has an open window.
+    bool inCheck; ///< Whether the side to move is in check.
+    bool futile;  ///< Whether quiet moves that do not give check may be skipped.
+};
+
+/**
+ * @struct SplitPoint
+ * @brief A node whose younger moves are shared between threads (Young Brothers Wait).
+ *
+ * The thread that splits the node keeps it on its stack until every task has
+ * finished. Tasks copy the node's position, read its current alpha and
+ * report back under the mutex. A fail high raises the cutoff flag, which
+ * cancels the other tasks of this node and of every node split below it.
+ */
+struct SplitPoint
+{
+    Board board;                     ///< The position at the node.
+    SearchNode node;                 ///< The node's depth, window and pruning state.
+    SplitPoint *parent = nullptr;    ///< The split node this one was reached from, or nullptr.
+    std::mutex mutex;                ///< Guards alpha, the best score and move, and the line.
+    Score alpha = 0;                 ///< The score the side to move is guaranteed so far.
+    Score bestScore = 0;             ///< Best score of any move searched.
+    Move bestMove;                   ///< Move with the best score.
+    std::array<Move, MAX_PLY> pv;    ///< The line through the move that last raised alpha.
+    int pvLength = 0;                ///< Length of that line (0 if no task raised alpha).
+    std::atomic<int> pending{0};     ///< Tasks not yet finished.
+    std::atomic<bool> cutoff{false}; ///< Set when a move fails high.
+
+    /**
+     * @brief Checks whether this node or any split node above it has failed high.
+     *
+     * @return true If the remaining moves no longer need searching.
+     */
+    bool cancelled() const
+    {
+        for (const SplitPoint *splitPoint = this; splitPoint; splitPoint = splitPoint->parent)
+        {
+            if (splitPoint->cutoff.load(std::memory_order_relaxed))
+                return true;
+        }
+        return false;
+    }
+};
+
+namespace
+{
+    const Score NULL_WINDOW = 1;          ///< Width of the window used to test whether a move beats alpha.
+    const Score ASPIRATION_WINDOW = 50;   ///< Initial half-width of the window around the previous score.
+    const int ASPIRATION_MIN_DEPTH = 4;   ///< Iterations shallower than this use a full window.
+
+    const int NULL_MOVE_MIN_DEPTH = 3;    ///< Shallowest depth null-move pruning is tried at.
+    const int LMR_MIN_DEPTH = 3;          ///< Shallowest depth late moves are reduced at.
+    const int LMR_MIN_MOVES = 3;          ///< Moves searched at full depth before reductions start.
+
+    /// Lazy SMP helper i skips the iterations where (depth + SKIP_PHASE[i]) / SKIP_SIZE[i] is odd,
+    /// so that the helpers spread out over the next few depths instead of repeating the main thread
+    const int SKIP_SIZE[20] = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
+    const int SKIP_PHASE[20] = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+    int lateMoveReductions[64][64];       ///< Plies to reduce by, indexed [depth][move number].
+
+    using SearchThreads = std::vector<std::unique_ptr<SearchContext>>; ///< One context per search thread.
+
+    SearchThreads searchThreads; ///< Kept between searches so each thread's pawn table stays warm.
+
+    /**
+     * @brief Resets the per-search state of a thread's context. The pawn table is kept.
+     *
+     * @param context The context to reset.
+     * @param threadIndex The thread's index, 0 for the main thread.
+     * @param signals The signals of the new search.
+     */
+    void resetContext(SearchContext &context, int threadIndex, SearchSignals &signals)
+    {
+        context.time = TimeManager();
+        context.nodes.store(0, std::memory_order_relaxed);
+        context.stopped = false;
+        context.signals = &signals;
+        context.pondering = false;
+        context.threadIndex = threadIndex;
+        context.pool = nullptr;
+        context.splitPoint = nullptr;
+        context.heuristics.clear();
+        context.completedDepth = 0;
+        context.bestMove = Move();
+        context.ponderMove = Move();
+        context.bestScore = 0;
+        context.pvLength.fill(0);
+
+        // The root tries the previous iteration's best move first, so no line may survive from the last search
+        for (std::array<Move, MAX_PLY> &line : context.pvTable)
+        {
+            line.fill(Move());
+        }
+    }
+
+    /**
+     * @brief Checks whether the thread should unwind.
+     *
+     * @param context The state of the thread's search.
+     * @return true If the search was stopped, or a split node above the thread failed high.
+     */
+    bool aborted(SearchContext &context)
+    {
+        if (!context.stopped && context.signals->stop.load(std::memory_order_relaxed))
+        {
+            context.stopped = true;
+        }
+        return context.stopped || (context.splitPoint && context.splitPoint->cancelled());
+    }
+
+    /**
+     * @brief Checks whether the clock is still being ignored because the search is pondering.
+     *
+     * The first check after a ponderhit starts the time budgets.
+     *
+     * @param context The state of the main thread's search.
+     * @return true If the search is still pondering.
+     */
+    bool stillPondering(SearchContext &context)
+    {
+        if (context.pondering && !context.signals->ponder.load(std::memory_order_relaxed))
+        {
+            context.pondering = false;
+            context.time.ponderHit();
+        }
+        return context.pondering;
+    }
+
+    /**
+     * @brief Raises the stop signal once the main thread's hard time limit has passed.
+     *
+     * The clock is ignored while pondering, and by the helper threads, whose
+     * time managers are never started.
+     *
+     * @param context The state of the thread's search.
+     */
+    void checkClock(SearchContext &context)
+    {
+        if (context.threadIndex == 0 && !stillPondering(context) && context.time.hardLimitReached())
+        {
+            context.signals->stop.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Counts a node. The main thread also reads the clock every few thousand nodes.
+     *
+     * @param context The state of the thread's search.
+     * @return true If the search should unwind.
+     */
+    bool visitNode(SearchContext &context)
+    {
+        // Only this thread writes its count, so a plain load and store is enough
+        uint64_t nodes = context.nodes.load(std::memory_order_relaxed) + 1;
+        context.nodes.store(nodes, std::memory_order_relaxed);
+
+        if ((nodes & (SearchContext::NODES_BETWEEN_TIME_CHECKS - 1)) == 0)
+        {
+            checkClock(context);
+        }
+        return aborted(context);
+    }
+
+    /**
+     * @brief Adds up the nodes visited by every thread.
+     *
+     * @param threads The contexts of the search threads.
+     * @return uint64_t The total node count.
+     */
+    uint64_t totalNodes(const SearchThreads &threads)
+    {
+        uint64_t nodes = 0;
+        for (const std::unique_ptr<SearchContext> &thread : threads)
+        {
+            nodes += thread->nodes.load(std::memory_order_relaxed);
+        }
+        return nodes;
+    }
+
+    /**
+     * @brief Checks whether a lazy SMP helper skips an iteration.
+     *
+     * @param threadIndex The helper's index (1 and up).
+     * @param depth The depth of the iteration.
+     * @return true If the helper moves straight on to the next depth.
+     */
+    bool skipsDepth(int threadIndex, int depth)
+    {
+        int i = (threadIndex - 1) % 20;
+        return ((depth + SKIP_PHASE[i]) / SKIP_SIZE[i]) % 2 != 0;
+    }
+
+    /**
+     * @brief Evaluates the position for the side to move.
+     *
+     * @param context The searching thread, whose pawn table is used.
+     * @param board The current state of the chessboard.
+     * @return Score The evaluation, positive if the side to move is better.
+     */
+    Score relativeEvaluation(SearchContext &context, const Board &board)
+    {
+        Score score = evaluation(board, context.pawnTable);
+        return (board.currentColour == WHITE) ? score : -score;
+    }
+
+    /**
+     * @brief Writes a score as a UCI "cp <centipawns>" or "mate <moves>" string.
+     *
+     * @param score The score from the side to move's point of view.
+     * @return std::string The score for an info line; negative mates are being mated.
+     */
+    std::string uciScore(Score score)
+    {
+        if (score >= SCORE_MATE_BOUND)
+            return "mate " + std::to_string((SCORE_MATE - score + 1) / 2);
+        if (score <= -SCORE_MATE_BOUND)
+            return "mate " + std::to_string(-(SCORE_MATE + score) / 2);
+        return "cp " + std::to_string(score);
+    }
+
+    /**
+     * @brief Writes the principal variation as UCI moves separated by spaces.
+     *
+     * @param context The state of the search.
+     * @return std::string The moves of the principal variation.
+     */
+    std::string principalVariation(const SearchContext &context)
+    {
+        std::string line;
+        for (int i = 0; i < context.pvLength[0]; ++i)
+        {
+            line += (i ? " " : "") + convertToUCI(context.pvTable[0][i]);
+        }
+        return line;
+    }
+}
+
+/**
+ * @brief Builds the late move reduction table. Must be called once at startup before searching.
+ *
+ * The reduction grows with the logarithm of both the remaining depth and the
+ * number of moves already searched, so late moves in deep searches are cut
+ * the most.
+ */
+void initialiseSearch()
+{
+    for (int depth = 0; depth < 64; ++depth)
+    {
+        for (int moveNumber = 0; moveNumber < 64; ++moveNumber)
+        {
+            lateMoveReductions[depth][moveNumber] =
+                (depth == 0 || moveNumber == 0) ? 0 : static_cast<int>(0.75 + std::log(depth) * std::log(moveNumber) / 2.25);
+        }
+    }
+}
 
 /**
- * @brief Performs the Alpha-Beta pruning search algorithm to find the best move evaluation.
+ * @brief Searches only captures and promotions until the position is quiet.
+ *
+ * The side to move may "stand pat" and accept the static evaluation instead
+ * of capturing, so the evaluation is a lower bound and can cut off at once.
+ * Captures that lose material by static exchange are skipped. When in check
+ * every evasion is searched instead, since standing pat is not an option.
  *
- * @param board The current state of the chessboard.
+ * @param context The state of the current search.
+ * @param board The current state of the chessboard, restored before returning.
+ * @param ply The distance from the root.
+ * @param alpha The score the side to move is already guaranteed.
+ * @param beta The score the opponent will not allow the side to move to exceed.
+ * @return Score The score for the side to move (meaningless if the search was stopped).
+ */
+Score quiescence(SearchContext &context, Board &board, int ply, Score alpha, Score beta)
+{
+    if (visitNode(context))
+    {
+        return 0;
+    }
+
+    context.pvLength[ply] = 0;
+
+    // Checked before the evasions too, or a run of checks would index past the per-ply tables
+    if (ply >= MAX_PLY - 1)
+    {
+        return relativeEvaluation(context, board);
+    }
+
+    bool inCheck = isInCheck(board, board.currentColour);
+    Score bestScore = -SCORE_INFINITE;
+
+    if (!inCheck)
+    {
+        bestScore = relativeEvaluation(context, board);
+        if (bestScore >= beta)
+        {
+            return bestScore;
+        }
+        alpha = std::max(alpha, bestScore);
+    }
+
+    MoveList moves;
+    generateMoves(board.currentColour, board, moves);
+
+    if (inCheck && moves.empty())
+    {
+        return matedIn(ply);
+    }
+
+    MovePicker picker(board, moves, Move(), context.heuristics, ply);
+    Move move;
+
+    while (picker.next(move))
+    {
+        if (!inCheck)
+        {
+            if (!isCapture(board, move) && !move.isPromotion())
+                continue;
+            if (staticExchange(board, move) < 0)
+                continue;
+        }
+
+        MoveHistory history = makeMove(board, move);
+        Score score = -quiescence(context, board, ply + 1, -beta, -alpha);
+        unmakeMove(board, history);
+
+        if (aborted(context))
+        {
+            return 0;
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+        }
+
+        if (score > alpha)
+        {
+            alpha = score;
+            if (alpha >= beta)
+                break;
+        }
+    }
+
+    return bestScore;
+}
+
+namespace
+{
+    /**
+     * @brief Searches one move of a node with principal variation search.
+     *
+     * The eldest move gets the full window. Every later move gets a null
+     * window around alpha, reduced if it is quiet and late in the ordering,
+     * and is searched again at full depth and then with the full window only
+     * if it beats alpha.
+     *
+     * @param context The state of the current search.
+     * @param board The position at the node, restored before returning.
+     * @param move The move to search.
+     * @param node The node the move is played from.
+     * @param moveNumber How many moves of the node were searched before this one.
+     * @param alpha The node's alpha when the move is searched.
+     * @param score Set to the score of the move for the side to move at the node.
+     * @return true If the move was searched, false if futility pruning skipped it.
+     */
+    bool searchMove(SearchContext &context, Board &board, const Move &move, const SearchNode &node, int moveNumber,
+                    Score alpha, Score &score)
+    {
+        int depth = node.depth;
+        int ply = node.ply;
+        Score beta = node.beta;
+
+        bool quiet = !isCapture(board, move) && !move.isPromotion();
+        MoveHistory history = makeMove(board, move);
+
+        if (node.futile && quiet && moveNumber > 0 && !isInCheck(board, board.currentColour))
+        {
+            unmakeMove(board, history);
+            return false;
+        }
+
+        if (moveNumber == 0)
+        {
+            score = -alphaBeta(context, board, depth - 1, ply + 1, -beta, -alpha);
+        }
+        else
+        {
+            // Reduce quiet moves late in the ordering that do not give check
+            int reduction = 0;
+            if (depth >= LMR_MIN_DEPTH && moveNumber >= LMR_MIN_MOVES && quiet && !node.inCheck &&
+                !isInCheck(board, board.currentColour))
+            {
+                reduction = lateMoveReductions[std::min(depth, 63)][std::min(moveNumber, 63)];
+                if (node.pvNode)
+                    reduction -= 1;
+                reduction = std::max(0, std::min(reduction, depth - 2));
+            }
+
+            score = -alphaBeta(context, board, depth - 1 - reduction, ply + 1, -alpha - NULL_WINDOW, -alpha);
+
+            // A reduced move that beats alpha is searched again at full depth
+            if (reduction > 0 && score > alpha)
+            {
+                score = -alphaBeta(context, board, depth - 1, ply + 1, -alpha - NULL_WINDOW, -alpha);
+            }
+
+            if (score > alpha && score < beta)
+            {
+                score = -alphaBeta(context, board, depth - 1, ply + 1, -beta, -alpha);
+            }
+        }
+
+        unmakeMove(board, history);
+        return true;
+    }
+
+    /**
+     * @brief Searches one move of a split node and reports the result to it.
+     *
+     * Tasks whose node, or a split node above it, has already failed high are
+     * dropped without searching.
+     *
+     * @param context The state of the thread running the task.
+     * @param task The move and the node it is played from.
+     */
+    void runSplitTask(SearchContext &context, const SplitTask &task)
+    {
+        SplitPoint &splitPoint = *task.splitPoint;
+        const SearchNode &node = splitPoint.node;
+
+        SplitPoint *previous = context.splitPoint;
+        context.splitPoint = &splitPoint;
+
+        if (!aborted(context))
+        {
+            Board board = splitPoint.board;
+            bool quiet = !isCapture(board, task.move) && !task.move.isPromotion();
+
+            Score alpha;
+            {
+                std::lock_guard<std::mutex> lock(splitPoint.mutex);
+                alpha = splitPoint.alpha;
+            }
+
+            Score score;
+            if (searchMove(context, board, task.move, node, task.moveNumber, alpha, score) && !aborted(context))
+            {
+                std::lock_guard<std::mutex> lock(splitPoint.mutex);
+
+                if (score > splitPoint.bestScore)
+                {
+                    splitPoint.bestScore = score;
+                    splitPoint.bestMove = task.move;
+                }
+
+                if (score > splitPoint.alpha)
+                {
+                    splitPoint.alpha = score;
+                    splitPoint.pv[0] = task.move;
+                    for (int i = 0; i < context.pvLength[node.ply + 1]; ++i)
+                    {
+                        splitPoint.pv[i + 1] = context.pvTable[node.ply + 1][i];
+                    }
+                    splitPoint.pvLength = context.pvLength[node.ply + 1] + 1;
+                }
+
+                if (score >= node.beta)
+                {
+                    splitPoint.cutoff.store(true, std::memory_order_relaxed);
+                    if (quiet)
+                    {
+                        context.heuristics.updateQuietCutoff(board.currentColour, task.move, node.ply, node.depth);
+                    }
+                }
+            }
+        }
+
+        context.splitPoint = previous;
+
+        // The owner may return as soon as the count reaches zero, so the split point is not touched after this
+        splitPoint.pending.fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Shares the remaining moves of a node with the other threads and waits for them.
+     *
+     * The moves are pushed onto this thread's deque in reverse order, so that
+     * this thread takes them back best first while idle threads steal the
+     * latest ones. This thread only runs tasks of this node while it waits.
+     *
+     * @param context The state of the thread splitting the node.
+     * @param board The position at the node.
+     * @param picker The node's move picker, positioned after the first remaining move.
+     * @param move The first remaining move.
+     * @param node The node being split.
+     * @param alpha The node's alpha, updated with the tasks' results.
+     * @param bestScore The node's best score, updated with the tasks' results.
+     * @param bestMove The node's best move, updated with the tasks' results.
+     * @param movesSearched The number of moves already searched at the node.
+     */
+    void splitNode(SearchContext &context, const Board &board, MovePicker &picker, Move move, const SearchNode &node,
+                   Score &alpha, Score &bestScore, Move &bestMove, int movesSearched)
+    {
+        SplitPoint splitPoint;
+        splitPoint.board = board;
+        splitPoint.node = node;
+        splitPoint.parent = context.splitPoint;
+        splitPoint.alpha = alpha;
+        splitPoint.bestScore = bestScore;
+        splitPoint.bestMove = bestMove;
+
+        MoveList remaining;
+        do
+        {
+            remaining.push_back(move);
+        } while (picker.next(move));
+
+        splitPoint.pending.store(remaining.size(), std::memory_order_relaxed);
+        for (int i = remaining.size() - 1; i >= 0; --i)
+        {
+            context.pool->push(context.threadIndex, SplitTask{&splitPoint, remaining[i], movesSearched + i});
+        }
+
+        // While helpers hold the last moves the main thread visits no nodes, so it reads the clock here
+        SplitTask task;
+        while (splitPoint.pending.load(std::memory_order_acquire) > 0)
+        {
+            if (context.pool->pop(context.threadIndex, &splitPoint, task))
+            {
+                runSplitTask(context, task);
+            }
+            else
+            {
+                checkClock(context);
+                std::this_thread::yield();
+            }
+        }
+
+        alpha = splitPoint.alpha;
+        bestScore = splitPoint.bestScore;
+        bestMove = splitPoint.bestMove;
+        if (splitPoint.pvLength > 0)
+        {
+            std::copy(splitPoint.pv.begin(), splitPoint.pv.begin() + splitPoint.pvLength, context.pvTable[node.ply].begin());
+            context.pvLength[node.ply] = splitPoint.pvLength;
+        }
+    }
+}
+
+/**
+ * @brief Searches a position with negamax principal variation search.
+ *
+ * The first move is searched with the full window. Every later move is first
+ * searched with a null window around alpha, which is cheap and only proves it
+ * is no better; if it does beat alpha it is searched again with the full
+ * window. Scores are fail-soft and relative to the side to move.
+ *
+ * Two kinds of selectivity reduce the tree. Null-move pruning lets the
+ * opponent move twice with a reduced search; if that still fails high the
+ * position is good enough to cut off. It is skipped in check and when the
+ * side to move has only pawns, where passing can be the best move
+ * (zugzwang). Late move reductions search quiet moves late in the ordering
+ * at a reduced depth, and again at full depth only if they beat alpha.
+ *
+ * Close to the leaves the static evaluation is trusted further, with the
+ * margins in searchParameters. Reverse futility fails high when the
+ * evaluation is far above beta. Razoring drops into quiescence when it is
+ * far below alpha. Futility pruning skips quiet moves that cannot bring it
+ * up to alpha.
+ *
+ * When work stealing, a node at least searchParameters.splitDepth deep is
+ * split once its eldest move has been searched: its younger brothers become
+ * tasks that idle threads can steal, and a fail high in any of them cancels
+ * the rest.
+ *
+ * The main thread reads the clock every few thousand nodes. Once the hard
+ * time limit has passed it raises the stop signal, and every thread unwinds
+ * without storing anything in the transposition table, since the scores of
+ * an interrupted search are not reliable.
+ *
+ * @param context The state of the current search.
+ * @param board The current state of the chessboard, restored before returning.
  * @param depth How deep to look down the tree.
- * @param alpha The best score the maximising player can guarantee.
- * @param beta The best score the minimising player can guarentee.
- * @param maximisingPlayer Whether the current player is the maximising or minimising player.
- * @return float The best evaluation score found.
+ * @param ply The distance from the root.
+ * @param alpha The score the side to move is already guaranteed.
+ * @param beta The score the opponent will not allow the side to move to exceed.
+ * @param allowNullMove Whether null-move pruning may be tried (false straight after a null move).
+ * @return Score The score for the side to move (meaningless if the search was stopped).
  */
-float alphaBeta(Board board, int depth, float alpha, float beta, bool maximisingPlayer)
+Score alphaBeta(SearchContext &context, Board &board, int depth, int ply, Score alpha, Score beta, bool allowNullMove)
 {
+    if (visitNode(context))
+    {
+        return 0;
+    }
+
+    context.pvLength[ply] = 0;
+
+    if (ply >= MAX_PLY - 1)
+    {
+        return relativeEvaluation(context, board);
+    }
+
     if (depth == 0)
     {
-        return evaluation(board);
+        return quiescence(context, board, ply, alpha, beta);
+    }
+
+    bool pvNode = beta - alpha > NULL_WINDOW;
+
+    // Reuse a previous search of this position if it was deep enough. The root
+    // always searches, so that it has a move to play
+    TTEntry entry;
+    bool found = transpositionTable.probe(board.hashKey, entry);
+    if (found && entry.depth >= depth && ply > 0 && !pvNode)
+    {
+        Score ttScore = scoreFromTT(entry.score, ply);
+        if (entry.bound == BOUND_EXACT ||
+            (entry.bound == BOUND_LOWER && ttScore >= beta) ||
+            (entry.bound == BOUND_UPPER && ttScore <= alpha))
+        {
+            return ttScore;
+        }
     }
 
-    std::vector<Move> moves = generateMoves(board.currentColour, board);
+    Colour colour = board.currentColour;
+    bool inCheck = isInCheck(board, colour);
+    Score staticEval = inCheck ? -SCORE_INFINITE : relativeEvaluation(context, board);
+    bool frontier = !pvNode && !inCheck && ply > 0 && depth <= SearchParameters::MAX_PRUNING_DEPTH;
 
-    if (maximisingPlayer)
+    // Reverse futility: the evaluation is so far above beta that no reply will bring it back
+    if (frontier && staticEval - searchParameters.reverseFutilityMargin * depth >= beta)
     {
-        float maxEval = -1000000;
+        return staticEval;
+    }
 
-        for (const Move &move : moves)
+    // Razoring: the evaluation is so far below alpha that only captures could help
+    if (frontier && staticEval + searchParameters.razorMargin * depth < alpha)
+    {
+        Score score = quiescence(context, board, ply, alpha, beta);
+        if (aborted(context))
+        {
+            return 0;
+        }
+        if (score <= alpha)
         {
-            Board newBoard = board;   // Create a copy of the board
-            makeMove(newBoard, move); // Apply move to new board
+            return score;
+        }
+    }
 
-            float eval = alphaBeta(newBoard, depth - 1, alpha, beta, false);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
+    // Futility: quiet moves that do not give check cannot raise the evaluation up to alpha
+    bool futile = frontier && staticEval + searchParameters.futilityMargin * depth <= alpha;
 
-            if (beta <= alpha)
-                break; // Alpha-beta pruning
+    // Null-move pruning: if passing still fails high, a real move would too
+    Bitboard nonPawnMaterial = board.colourPieces[colour] & ~board.bitboards[colour][PAWN] & ~board.bitboards[colour][KING];
+    if (allowNullMove && !pvNode && !inCheck && ply > 0 && depth >= NULL_MOVE_MIN_DEPTH && nonPawnMaterial &&
+        staticEval >= beta)
+    {
+        int reduction = 3 + depth / 6;
+        MoveHistory history = makeNullMove(board);
+        Score score = -alphaBeta(context, board, std::max(0, depth - 1 - reduction), ply + 1, -beta, -beta + NULL_WINDOW, false);
+        unmakeNullMove(board, history);
+
+        if (aborted(context))
+        {
+            return 0;
+        }
+
+        // A mate found after passing is not proven, so only return a bound
+        if (score >= beta)
+        {
+            return (score >= SCORE_MATE_BOUND) ? beta : score;
         }
-        return maxEval;
     }
-    else
+
+    MoveList moves;
+    generateMoves(colour, board, moves);
+
+    if (moves.empty())
+    {
+        return inCheck ? matedIn(ply) : SCORE_DRAW;
+    }
+
+    // At the root the previous iteration's best move comes first
+    Move hashMove = found ? entry.move : Move();
+    if (ply == 0 && !context.pvTable[0][0].isNull())
+    {
+        hashMove = context.pvTable[0][0];
+    }
+
+    // Search the best move from the previous search first, then captures, killers and history
+    MovePicker picker(board, moves, hashMove, context.heuristics, ply);
+    Move move;
+
+    Score alphaOriginal = alpha;
+    Score bestScore = -SCORE_INFINITE;
+    Move bestMove;
+    int movesSearched = 0;
+
+    SearchNode node = {depth, ply, beta, pvNode, inCheck, futile};
+
+    while (picker.next(move))
     {
-        float minEval = 1000000;
+        // Young Brothers Wait: once the eldest move has been searched, the rest may be shared
+        if (context.pool && movesSearched > 0 && depth >= searchParameters.splitDepth)
+        {
+            splitNode(context, board, picker, move, node, alpha, bestScore, bestMove, movesSearched);
+            break;
+        }
+
+        bool quiet = !isCapture(board, move) && !move.isPromotion();
+        Score score;
+        if (!searchMove(context, board, move, node, movesSearched, alpha, score))
+        {
+            continue;
+        }
+        ++movesSearched;
+
+        if (aborted(context))
+        {
+            return 0;
+        }
 
-        for (const Move &move : moves)
+        if (score > bestScore)
         {
-            Board newBoard = board;   // Create a copy of the board
-            makeMove(newBoard, move); // Apply move to new board
+            bestScore = score;
+            bestMove = move;
+        }
 
-            float eval = alphaBeta(newBoard, depth - 1, alpha, beta, true);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
+        if (score > alpha)
+        {
+            alpha = score;
 
-            if (beta <= alpha)
-                break; // Alpha-beta pruning
+            // The line from here is this move followed by the child's line
+            context.pvTable[ply][0] = move;
+            for (int i = 0; i < context.pvLength[ply + 1]; ++i)
+            {
+                context.pvTable[ply][i + 1] = context.pvTable[ply + 1][i];
+            }
+            context.pvLength[ply] = context.pvLength[ply + 1] + 1;
         }
-        return minEval;
+
+        if (alpha >= beta)
+        {
+            if (quiet)
+            {
+                context.heuristics.updateQuietCutoff(colour, move, ply, depth);
+            }
+            break; // Alpha-beta pruning
+        }
+    }
+
+    if (aborted(context))
+    {
+        return 0;
+    }
+
+    Bound bound = BOUND_EXACT;
+    if (bestScore <= alphaOriginal)
+        bound = BOUND_UPPER;
+    else if (bestScore >= beta)
+        bound = BOUND_LOWER;
+
+    transpositionTable.store(board.hashKey, depth, scoreToTT(bestScore, ply), bound, bestMove);
+
+    return bestScore;
+}
+
+namespace
+{
+    /**
+     * @brief Finds the reply stored in the transposition table after a move.
+     *
+     * Used for the ponder move when the principal variation stops after one move.
+     *
+     * @param board The current state of the chessboard, restored before returning.
+     * @param move The move to play first.
+     * @return Move The stored best reply if it is legal, otherwise the null move.
+     */
+    Move hashedReply(Board &board, const Move &move)
+    {
+        MoveHistory history = makeMove(board, move);
+
+        Move reply;
+        TTEntry entry;
+        if (transpositionTable.probe(board.hashKey, entry) && !entry.move.isNull())
+        {
+            // A key collision could hand back a move that is not legal here
+            MoveList replies;
+            generateMoves(board.currentColour, board, replies);
+            for (int i = 0; i < replies.size(); ++i)
+            {
+                if (replies[i] == entry.move)
+                    reply = entry.move;
+            }
+        }
+
+        unmakeMove(board, history);
+        return reply;
+    }
+
+    /**
+     * @brief Runs iterative deepening on one thread until the depth limit or the stop signal.
+     *
+     * Each iteration searches one ply deeper than the last, starting with the
+     * previous iteration's principal variation. From ASPIRATION_MIN_DEPTH the
+     * window is centred on the previous score and widened whenever the search
+     * falls outside it. An iteration interrupted by the stop signal is
+     * discarded. Only the main thread reports its iterations and watches the
+     * soft time limit, which it ignores until a ponder search is confirmed;
+     * lazy SMP helpers skip some depths instead.
+     *
+     * @param context The state of this thread's search.
+     * @param board This thread's copy of the position, restored before returning.
+     * @param limits The time and depth limits from the go command.
+     * @param threads The contexts of every search thread, for the node count.
+     */
+    void iterativeDeepening(SearchContext &context, Board &board, const SearchLimits &limits, const SearchThreads &threads)
+    {
+        Score previousScore = 0;
+
+        for (int depth = 1; depth <= limits.depth; ++depth)
+        {
+            if (context.threadIndex > 0 && skipsDepth(context.threadIndex, depth))
+                continue;
+
+            Score delta = ASPIRATION_WINDOW;
+            Score alpha = -SCORE_INFINITE;
+            Score beta = SCORE_INFINITE;
+            if (depth >= ASPIRATION_MIN_DEPTH)
+            {
+                alpha = previousScore - delta;
+                beta = previousScore + delta;
+            }
+
+            Score score;
+            while (true)
+            {
+                score = alphaBeta(context, board, depth, 0, alpha, beta);
+                if (aborted(context))
+                    break;
+
+                // Widen the side of the window the score fell outside, and search again
+                if (score <= alpha)
+                    alpha = std::max(-SCORE_INFINITE, score - delta);
+                else if (score >= beta)
+                    beta = std::min(SCORE_INFINITE, score + delta);
+                else
+                    break;
+
+                delta *= 2;
+            }
+
+            if (aborted(context))
+                break;
+
+            previousScore = score;
+            context.completedDepth = depth;
+            context.bestScore = score;
+            if (context.pvLength[0] > 0)
+            {
+                context.bestMove = context.pvTable[0][0];
+                context.ponderMove = (context.pvLength[0] > 1) ? context.pvTable[0][1] : Move();
+            }
+
+            if (context.threadIndex > 0)
+                continue;
+
+            // Written in one piece so it cannot interleave with a reply from the UCI thread
+            uint64_t nodes = totalNodes(threads);
+            int64_t elapsed = context.time.elapsed();
+            std::ostringstream info;
+            info << "info depth " << depth
+                 << " score " << uciScore(score)
+                 << " nodes " << nodes
+                 << " nps " << nodes * 1000 / std::max<int64_t>(1, elapsed)
+                 << " time " << elapsed
+                 << " pv " << principalVariation(context) << "\n";
+            std::cout << info.str() << std::flush;
+
+            if (!stillPondering(context) && context.time.softLimitReached())
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Empties every search thread's pawn table, for a new game.
+ *
+ * Must not be called while a search is running.
+ */
+void clearPawnTables()
+{
+    for (std::unique_ptr<SearchContext> &thread : searchThreads)
+    {
+        thread->pawnTable.clear();
+    }
+}
+
+/**
+ * @brief Searches for the best move with iterative deepening within the given limits.
+ *
+ * With one thread the main thread searches alone. With more, the default is
+ * lazy SMP: every helper runs its own iterative deepening on its own copy of
+ * the board, with its own killers and history, and the threads share work
+ * only through the transposition table. The main thread decides when to
+ * stop, and the move comes from whichever thread completed the deepest
+ * iteration. With work stealing enabled only the main thread iterates, and
+ * the helpers instead steal the younger moves of split nodes.
+ *
+ * While pondering the clock is ignored; once the ponder flag is cleared the
+ * time budgets start and the search carries on as a normal timed search.
+ *
+ * @param board The current state of the chessboard, restored before returning.
+ * @param limits The time and depth limits from the go command.
+ * @param signals Lets another thread stop the search or end pondering. The stop
+ * flag is also raised once the search has finished, to stop the helpers.
+ * @return SearchResult The best move found and the reply to ponder on.
+ */
+SearchResult findBestMove(Board &board, const SearchLimits &limits, SearchSignals &signals)
+{
+    MoveList moves;
+    generateMoves(board.currentColour, board, moves);
+    if (moves.empty())
+    {
+        return SearchResult();
+    }
+
+    int threadCount = std::max(1, std::min(searchParameters.threads, SearchParameters::MAX_THREADS));
+
+    SearchThreads &threads = searchThreads;
+    threads.resize(threadCount);
+    for (int i = 0; i < threadCount; ++i)
+    {
+        if (!threads[i])
+        {
+            threads[i].reset(new SearchContext());
+        }
+        resetContext(*threads[i], i, signals);
+    }
+
+    SearchContext &mainThread = *threads[0];
+    mainThread.time.start(limits, board.currentColour);
+    mainThread.pondering = limits.ponder;
+    transpositionTable.newSearch();
+
+    if (threadCount > 1 && searchParameters.workStealing)
+    {
+        WorkStealingPool pool;
+        for (std::unique_ptr<SearchContext> &thread : threads)
+        {
+            thread->pool = &pool;
+        }
+
+        pool.start(threadCount, [&threads](int worker, const SplitTask &task)
+                   { runSplitTask(*threads[worker], task); });
+        iterativeDeepening(mainThread, board, limits, threads);
+        signals.stop.store(true, std::memory_order_relaxed);
+        pool.stop();
+    }
+    else
+    {
+        // Copy the board for every helper before any thread starts moving pieces on it
+        std::vector<Board> boards(threadCount - 1, board);
+        std::vector<std::thread> helpers;
+        for (int i = 1; i < threadCount; ++i)
+        {
+            helpers.emplace_back([&, i]()
+                                 { iterativeDeepening(*threads[i], boards[i - 1], limits, threads); });
+        }
+
+        iterativeDeepening(mainThread, board, limits, threads);
+
+        signals.stop.store(true, std::memory_order_relaxed);
+        for (std::thread &helper : helpers)
+        {
+            helper.join();
+        }
+    }
+
+    // Take the move of the deepest completed iteration, preferring the main thread on ties
+    const SearchContext *best = &mainThread;
+    for (const std::unique_ptr<SearchContext> &thread : threads)
+    {
+        if (thread->completedDepth > best->completedDepth && !thread->bestMove.isNull())
+        {
+            best = thread.get();
+        }
+    }
+
+    SearchResult result;
+    result.bestMove = best->bestMove.isNull() ? moves[0] : best->bestMove;
+    result.ponderMove = best->ponderMove;
+    if (result.ponderMove.isNull())
+    {
+        result.ponderMove = hashedReply(board, result.bestMove);
     }
-}
\ No newline at end of file
+    return result;
+}
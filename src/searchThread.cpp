@@ -0,0 +1,112 @@
+/**
+ * @file searchThread.cpp
+ * @author Seán Rourke
+ * @brief This file implements searchThread.h.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <iostream>
+#include <string>
+#include "searchThread.h"
+#include "uciConversion.h"
+
+SearchThread::SearchThread()
+{
+    // Started here rather than in the initialiser list, so every member exists before loop() runs
+    thread = std::thread(&SearchThread::loop, this);
+}
+
+SearchThread::~SearchThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+        stopRequested = true;
+        signals.stop = true;
+    }
+    condition.notify_all();
+    thread.join();
+}
+
+void SearchThread::go(const Board &position, const SearchLimits &searchLimits)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return !searching; });
+
+    board = position;
+    limits = searchLimits;
+    stopRequested = false;
+    pondering = limits.ponder;
+    signals.stop = false;
+    signals.ponder = limits.ponder;
+    searching = true;
+
+    lock.unlock();
+    condition.notify_all();
+}
+
+void SearchThread::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+        signals.stop = true;
+    }
+    condition.notify_all();
+}
+
+void SearchThread::ponderHit()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pondering = false;
+        signals.ponder = false;
+    }
+    condition.notify_all();
+}
+
+void SearchThread::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this]() { return !searching; });
+}
+
+void SearchThread::loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true)
+    {
+        condition.wait(lock, [this]() { return searching || quitting; });
+        if (quitting)
+        {
+            return;
+        }
+
+        // The board and limits are only written by go() while no search is running
+        lock.unlock();
+        SearchResult result = findBestMove(board, limits, signals);
+        lock.lock();
+
+        // An infinite search may only report once the GUI has said stop, and a ponder search
+        // once it has said stop or ponderhit
+        if (limits.infinite || limits.ponder)
+        {
+            condition.wait(lock, [this]() { return stopRequested || (!limits.infinite && !pondering); });
+        }
+
+        // Written in one piece so it cannot interleave with a reply from the UCI thread
+        std::string reply = "bestmove " + (result.bestMove.isNull() ? std::string("(none)") : convertToUCI(result.bestMove));
+        if (!result.ponderMove.isNull())
+        {
+            reply += " ponder " + convertToUCI(result.ponderMove);
+        }
+        std::cout << reply + "\n" << std::flush;
+
+        searching = false;
+        condition.notify_all();
+    }
+}
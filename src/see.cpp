@@ -0,0 +1,103 @@
+/**
+ * @file see.cpp
+ * @author Seán Rourke
+ * @brief Implements see.h using the swap list algorithm.
+ * @date 2025
+ *
+ * The captures are played out on an occupancy bitboard only: each capturing
+ * piece is removed from the occupancy, and the attackers of the square are
+ * recomputed so sliders behind it are uncovered. The value of each capture
+ * is recorded, and the list is then folded back from the end, letting each
+ * side stop at the point that is best for it.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include "see.h"
+
+/**
+ * @brief Works out the material won or lost by a move if both sides keep
+ * recapturing on its destination square with their least valuable attacker.
+ *
+ * @param board The current state of the chessboard.
+ * @param move The move to evaluate.
+ * @return int The expected material gain for the side making the move, in centipawns.
+ */
+int staticExchange(const Board &board, const Move &move)
+{
+    if (move.castling())
+    {
+        return 0;
+    }
+
+    int from = move.from();
+    int to = move.to();
+
+    int gain[32];
+    int depth = 0;
+
+    Piece victim = move.enPassant() ? PAWN : board.pieceOn(to);
+    Piece attacker = board.pieceOn(from);
+
+    gain[0] = (victim == EMPTY) ? 0 : seePieceValues[victim];
+    int pieceOnSquare = seePieceValues[attacker];
+    if (move.isPromotion())
+    {
+        gain[0] += seePieceValues[move.promotionPiece()] - seePieceValues[PAWN];
+        pieceOnSquare = seePieceValues[move.promotionPiece()];
+    }
+
+    Bitboard occupancy = board.allPieces ^ (1ULL << from);
+    if (move.enPassant())
+    {
+        occupancy ^= 1ULL << (to + ((board.currentColour == WHITE) ? -8 : 8));
+    }
+
+    Colour side = static_cast<Colour>(!board.currentColour);
+    Bitboard attackers = board.attackersTo(to, occupancy) & occupancy;
+
+    while (true)
+    {
+        Bitboard sideAttackers = attackers & board.colourPieces[side];
+        if (!sideAttackers)
+        {
+            break;
+        }
+
+        // Recapture with the least valuable piece
+        int piece = PAWN;
+        while (!(board.bitboards[side][piece] & sideAttackers))
+        {
+            ++piece;
+        }
+
+        // The king can only recapture if the square is no longer defended
+        if (piece == KING && (attackers & board.colourPieces[!side]))
+        {
+            break;
+        }
+
+        ++depth;
+        gain[depth] = pieceOnSquare - gain[depth - 1];
+        if (depth == 31)
+        {
+            break;
+        }
+
+        Bitboard capturer = board.bitboards[side][piece] & sideAttackers;
+        occupancy ^= capturer & -capturer;
+        attackers = board.attackersTo(to, occupancy) & occupancy;
+        pieceOnSquare = seePieceValues[piece];
+        side = static_cast<Colour>(!side);
+    }
+
+    while (depth > 0)
+    {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        --depth;
+    }
+
+    return gain[0];
+}
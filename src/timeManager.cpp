@@ -0,0 +1,106 @@
+/**
+ * @file timeManager.cpp
+ * @author Seán Rourke
+ * @brief Implements timeManager.h to budget search time per move.
+ * @date 2025
+ *
+ * Without movestogo the remaining time is shared over an assumed thirty more
+ * moves, and the share is never more than a fifth of the clock. The soft
+ * budget is that share plus most of the increment; the hard budget allows up
+ * to four times as long for an iteration that is nearly finished. Neither
+ * budget may use more than half of the remaining clock, so a large increment
+ * or movestogo 1 cannot spend the whole of it.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include "timeManager.h"
+
+/**
+ * @brief Starts the clock and works out the budgets for a move.
+ *
+ * @param limits The limits from the go command.
+ * @param colour The side the engine is moving for.
+ */
+void TimeManager::start(const SearchLimits &limits, Colour colour)
+{
+    startTime = std::chrono::steady_clock::now();
+    softLimit = -1;
+    hardLimit = -1;
+
+    if (limits.infinite)
+    {
+        return;
+    }
+
+    if (limits.moveTime >= 0)
+    {
+        softLimit = hardLimit = std::max<int64_t>(1, limits.moveTime - MOVE_OVERHEAD_MS);
+        return;
+    }
+
+    int64_t time = (colour == WHITE) ? limits.whiteTime : limits.blackTime;
+    int64_t increment = (colour == WHITE) ? limits.whiteIncrement : limits.blackIncrement;
+    if (time < 0)
+    {
+        return;
+    }
+
+    int64_t available = std::max<int64_t>(1, time - MOVE_OVERHEAD_MS);
+    int movesToGo = (limits.movesToGo > 0) ? std::min(limits.movesToGo, 30) : 30;
+
+    int64_t maximum = std::max<int64_t>(1, available / 2);
+    int64_t share = std::min(available / movesToGo, available / 5);
+
+    softLimit = std::max<int64_t>(1, std::min(maximum, share + increment * 3 / 4));
+    hardLimit = std::min(maximum, softLimit * 4);
+}
+
+/**
+ * @brief Gives the time since the search started.
+ *
+ * @return int64_t The elapsed time in milliseconds.
+ */
+int64_t TimeManager::elapsed() const
+{
+    auto now = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime).count();
+}
+
+/**
+ * @brief Checks whether there is time left to start another iteration.
+ *
+ * @return true If the soft budget has been used up.
+ * @return false If there is time for another iteration.
+ */
+bool TimeManager::softLimitReached() const
+{
+    return softLimit >= 0 && elapsed() >= softLimit;
+}
+
+/**
+ * @brief Checks whether the search must stop immediately.
+ *
+ * @return true If the hard budget has been used up.
+ * @return false If the search may continue.
+ */
+bool TimeManager::hardLimitReached() const
+{
+    return hardLimit >= 0 && elapsed() >= hardLimit;
+}
+
+/**
+ * @brief Starts the budgets from now, once a ponder search has become a normal search.
+ *
+ * The elapsed time keeps counting from the start of the ponder search.
+ */
+void TimeManager::ponderHit()
+{
+    int64_t pondered = elapsed();
+    if (softLimit >= 0)
+        softLimit += pondered;
+    if (hardLimit >= 0)
+        hardLimit += pondered;
+}
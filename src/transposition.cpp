@@ -0,0 +1,197 @@
+/**
+ * @file transposition.cpp
+ * @author Seán Rourke
+ * @brief Implements transposition.h to cache search results by position.
+ * @date 2025
+ *
+ * Each entry packs the best move, score, depth, bound and search generation
+ * into one 64-bit word:
+ *
+ *   bits  0-15  best move
+ *   bits 16-31  score (signed centipawns)
+ *   bits 32-47  unused
+ *   bits 48-55  depth
+ *   bits 56-57  bound
+ *   bits 58-63  generation
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "transposition.h"
+
+TranspositionTable transpositionTable;
+
+namespace
+{
+    const int GENERATION_BITS = 6;
+    const int GENERATION_MASK = (1 << GENERATION_BITS) - 1;
+
+    uint64_t packData(const Move &move, Score score, int depth, Bound bound, uint8_t generation)
+    {
+        // Every score fits in 16 bits, mates included
+        uint16_t scoreBits = static_cast<uint16_t>(static_cast<int16_t>(score));
+
+        return move.data |
+               (uint64_t(scoreBits) << 16) |
+               (uint64_t(depth & 0xFF) << 48) |
+               (uint64_t(bound) << 56) |
+               (uint64_t(generation & GENERATION_MASK) << 58);
+    }
+
+    int depthOf(uint64_t data) { return (data >> 48) & 0xFF; }
+    Bound boundOf(uint64_t data) { return static_cast<Bound>((data >> 56) & 3); }
+    int generationOf(uint64_t data) { return (data >> 58) & GENERATION_MASK; }
+}
+
+/**
+ * @brief Construct a new Transposition Table object.
+ *
+ * @param megabytes The size of the table in megabytes.
+ */
+TranspositionTable::TranspositionTable(std::size_t megabytes)
+{
+    resize(megabytes);
+}
+
+/**
+ * @brief Reallocates the table to a new size, discarding all entries.
+ *
+ * The bucket count is rounded down to a power of two so a key can be mapped
+ * to its bucket with a mask.
+ *
+ * @param megabytes The size of the table in megabytes.
+ */
+void TranspositionTable::resize(std::size_t megabytes)
+{
+    std::size_t bucketCount = 1;
+    while (bucketCount * 2 * sizeof(Bucket) <= megabytes * 1024 * 1024)
+    {
+        bucketCount *= 2;
+    }
+
+    buckets.reset(new Bucket[bucketCount]);
+    bucketMask = bucketCount - 1;
+    generation = 0;
+}
+
+/**
+ * @brief Removes all entries from the table.
+ */
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i <= bucketMask; ++i)
+    {
+        for (Slot &slot : buckets[i].slots)
+        {
+            slot.keyXorData.store(0, std::memory_order_relaxed);
+            slot.data.store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+/**
+ * @brief Marks the start of a new search so older entries are replaced first.
+ */
+void TranspositionTable::newSearch()
+{
+    generation = (generation + 1) & GENERATION_MASK;
+}
+
+/**
+ * @brief Looks up a position in the table.
+ *
+ * An entry only matches if its stored key XORed with its data gives back the
+ * probed key, which also rejects entries torn by a concurrent store.
+ *
+ * @param key The Zobrist key of the position.
+ * @param entry Filled in with the stored data if the position is found.
+ * @return true If the position was found.
+ * @return false If the position was not found.
+ */
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const
+{
+    const Bucket &bucket = bucketFor(key);
+
+    for (const Slot &slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+
+        if ((keyXorData ^ data) != key || boundOf(data) == BOUND_NONE)
+        {
+            continue;
+        }
+
+        entry.score = static_cast<int16_t>(data >> 16);
+        entry.move.data = static_cast<uint16_t>(data);
+        entry.depth = depthOf(data);
+        entry.bound = boundOf(data);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Stores a search result in the table.
+ *
+ * An existing entry for the same position is overwritten unless it holds a much
+ * deeper result from the current search. Otherwise the entry
+ * replaced is the one with the lowest depth, counting each search generation
+ * of age as eight plies, so deep results survive but stale ones do not.
+ *
+ * @param key The Zobrist key of the position.
+ * @param depth The depth the position was searched to.
+ * @param score The score found.
+ * @param bound How the score bounds the true value.
+ * @param move The best move found (the null move if none).
+ */
+void TranspositionTable::store(uint64_t key, int depth, Score score, Bound bound, const Move &move)
+{
+    Bucket &bucket = bucketFor(key);
+    Slot *replace = &bucket.slots[0];
+    int lowestWorth = 1 << 30;
+
+    for (Slot &slot : bucket.slots)
+    {
+        uint64_t data = slot.data.load(std::memory_order_relaxed);
+        uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+
+        if ((keyXorData ^ data) == key || boundOf(data) == BOUND_NONE)
+        {
+            bool samePosition = (keyXorData ^ data) == key;
+
+            // Keep a much deeper result for this position from the current search
+            if (samePosition && bound != BOUND_EXACT && generationOf(data) == generation &&
+                depth < depthOf(data) - 2)
+            {
+                return;
+            }
+
+            // Keep the previous best move if this search did not find one
+            Move bestMove = move;
+            if (move.isNull() && samePosition)
+            {
+                bestMove.data = static_cast<uint16_t>(data);
+            }
+            uint64_t newData = packData(bestMove, score, depth, bound, generation);
+            slot.data.store(newData, std::memory_order_relaxed);
+            slot.keyXorData.store(key ^ newData, std::memory_order_relaxed);
+            return;
+        }
+
+        int age = (generation - generationOf(data)) & GENERATION_MASK;
+        int worth = depthOf(data) - 8 * age;
+        if (worth < lowestWorth)
+        {
+            lowestWorth = worth;
+            replace = &slot;
+        }
+    }
+
+    uint64_t newData = packData(move, score, depth, bound, generation);
+    replace->data.store(newData, std::memory_order_relaxed);
+    replace->keyXorData.store(key ^ newData, std::memory_order_relaxed);
+}
@@ -8,6 +8,7 @@
  *
  */
 
+#include <stdexcept>
 #include "uciConversion.h"
 
 /**
@@ -15,30 +16,30 @@
  *
  * @param move The move who's squares are being converted.
  */
-std::string convertToUCI(Move &move)
+std::string convertToUCI(const Move &move)
 {
 
     std::string moveString;
 
-    moveString += 'a' + (move.from % 8);
-    moveString += '1' + (move.from / 8);
+    moveString += 'a' + (move.from() % 8);
+    moveString += '1' + (move.from() / 8);
 
-    moveString += 'a' + (move.to % 8);
-    moveString += '1' + (move.to / 8);
+    moveString += 'a' + (move.to() % 8);
+    moveString += '1' + (move.to() / 8);
 
-    if (move.promotionPiece == QUEEN)
+    if (move.promotionPiece() == QUEEN)
     {
         moveString += "q";
     }
-    else if (move.promotionPiece == ROOK)
+    else if (move.promotionPiece() == ROOK)
     {
         moveString += "r";
     }
-    else if (move.promotionPiece == BISHOP)
+    else if (move.promotionPiece() == BISHOP)
     {
         moveString += "b";
     }
-    else if (move.promotionPiece == KNIGHT)
+    else if (move.promotionPiece() == KNIGHT)
     {
         moveString += "n";
     }
@@ -49,60 +50,61 @@ std::string convertToUCI(Move &move)
 /**
  * @brief Converts a move from UCI notation to numerical representation.
  *
+ * @param board The current state of the chessboard.
  * @param moveString The move who's squares are being converted.
  */
-Move convertFromUCI(Board &board, std::string &moveString)
+Move convertFromUCI(const Board &board, std::string_view moveString)
 {
-    if (moveString.length() < 4 || moveString.length() > 6)
+    if (moveString.length() != 4 && moveString.length() != 5)
     {
         throw std::invalid_argument("Invalid UCI move string");
     }
 
-    Move move;
-    move.from = (moveString[1] - '1') * 8 + (moveString[0] - 'a'); // Convert from UCI to index
-    move.to = (moveString[3] - '1') * 8 + (moveString[2] - 'a');   // Convert to UCI to index
-    move.promotionPiece = -1;                                      // Default to no promotion
-    move.castling = false;
-    Piece piece = board.pieces[move.from];
-
-    if (moveString == "e1g1" && piece == KING)
-    {
-        move.castling = true;
-    }
-    if (moveString == "e1c1" && piece == KING)
-    {
-        move.castling = true;
-    }
-    if (moveString == "e8g8" && piece == KING)
+    for (int i = 0; i < 4; i += 2)
     {
-        move.castling = true;
-    }
-    if (moveString == "e8c8" && piece == KING)
-    {
-        move.castling = true;
+        if (moveString[i] < 'a' || moveString[i] > 'h' || moveString[i + 1] < '1' || moveString[i + 1] > '8')
+        {
+            throw std::invalid_argument("Invalid UCI move string");
+        }
     }
 
+    int from = (moveString[1] - '1') * 8 + (moveString[0] - 'a'); // Convert from UCI to index
+    int to = (moveString[3] - '1') * 8 + (moveString[2] - 'a');   // Convert to UCI to index
+    Piece piece = board.pieceOn(from);
+
     // Check for promotion
     if (moveString.length() == 5)
     {
         switch (moveString[4])
         {
         case 'q':
-            move.promotionPiece = QUEEN;
-            break;
+            return Move(from, to, QUEEN);
         case 'r':
-            move.promotionPiece = ROOK;
-            break;
+            return Move(from, to, ROOK);
         case 'b':
-            move.promotionPiece = BISHOP;
-            break;
+            return Move(from, to, BISHOP);
         case 'n':
-            move.promotionPiece = KNIGHT;
-            break;
+            return Move(from, to, KNIGHT);
         default:
             throw std::invalid_argument("Invalid promotion piece");
         }
     }
 
-    return move;
+    if (piece == KING && (moveString == "e1g1" || moveString == "e1c1" ||
+                          moveString == "e8g8" || moveString == "e8c8"))
+    {
+        return Move(from, to, CASTLING);
+    }
+
+    if (piece == PAWN && (to - from == 16 || from - to == 16))
+    {
+        return Move(from, to, DOUBLE_PUSH);
+    }
+
+    if (piece == PAWN && to == board.enPassantSquare)
+    {
+        return Move(from, to, EN_PASSANT);
+    }
+
+    return Move(from, to);
 }
\ No newline at end of file
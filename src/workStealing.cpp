@@ -0,0 +1,97 @@
+/**
+ * @file workStealing.cpp
+ * @author Seán Rourke
+ * @brief This file implements workStealing.h.
+ * @date 2025
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include "workStealing.h"
+
+WorkStealingPool::~WorkStealingPool()
+{
+    stop();
+}
+
+void WorkStealingPool::start(int workers, TaskRunner runner)
+{
+    stop();
+
+    workerCount = std::max(1, workers);
+    deques.reset(new TaskDeque[workerCount]);
+    runTask = std::move(runner);
+    running = true;
+
+    for (int worker = 1; worker < workerCount; ++worker)
+    {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+    }
+}
+
+void WorkStealingPool::stop()
+{
+    running = false;
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+}
+
+void WorkStealingPool::push(int worker, const SplitTask &task)
+{
+    TaskDeque &deque = deques[worker];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.tasks.push_back(task);
+}
+
+bool WorkStealingPool::pop(int worker, const SplitPoint *splitPoint, SplitTask &task)
+{
+    TaskDeque &deque = deques[worker];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.tasks.empty() || deque.tasks.back().splitPoint != splitPoint)
+    {
+        return false;
+    }
+
+    task = deque.tasks.back();
+    deque.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int worker, SplitTask &task)
+{
+    // Start with the next worker so that thieves spread out over the victims
+    for (int i = 1; i < workerCount; ++i)
+    {
+        TaskDeque &deque = deques[(worker + i) % workerCount];
+        std::lock_guard<std::mutex> lock(deque.mutex);
+        if (!deque.tasks.empty())
+        {
+            task = deque.tasks.front();
+            deque.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int worker)
+{
+    SplitTask task;
+    while (running.load(std::memory_order_relaxed))
+    {
+        if (steal(worker, task))
+        {
+            runTask(worker, task);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
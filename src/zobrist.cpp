@@ -0,0 +1,67 @@
+/**
+ * @file zobrist.cpp
+ * @author Seán Rourke
+ * @brief Implements zobrist.h by generating the hashing keys.
+ * @date 2025
+ *
+ * The keys are produced by a fixed-seed SplitMix64 generator evaluated at
+ * compile time, so every build and every run hashes positions identically.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "zobrist.h"
+
+namespace
+{
+    /**
+     * @brief Advances a SplitMix64 generator and returns its next output.
+     *
+     * @param state The generator state.
+     * @return uint64_t The next random number.
+     */
+    constexpr uint64_t splitMix64(uint64_t &state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * @brief Fills a set of Zobrist keys from a fixed seed.
+     *
+     * @return ZobristKeys The generated keys.
+     */
+    constexpr ZobristKeys generateKeys()
+    {
+        ZobristKeys keys = {};
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+
+        for (int colour = 0; colour < MAX_COLOUR; ++colour)
+            for (int piece = 0; piece < MAX_PIECE_TYPE; ++piece)
+                for (int square = 0; square < 64; ++square)
+                    keys.pieces[colour][piece][square] = splitMix64(state);
+
+        // Each combination of rights is the XOR of a key per right, so the
+        // key can be looked up directly from the rights mask
+        uint64_t rightKeys[4] = {};
+        for (int right = 0; right < 4; ++right)
+            rightKeys[right] = splitMix64(state);
+
+        for (int rights = 0; rights < 16; ++rights)
+            for (int right = 0; right < 4; ++right)
+                if (rights & (1 << right))
+                    keys.castling[rights] ^= rightKeys[right];
+
+        for (int file = 0; file < BOARD_SIZE; ++file)
+            keys.enPassant[file] = splitMix64(state);
+
+        keys.blackToMove = splitMix64(state);
+
+        return keys;
+    }
+}
+
+constexpr ZobristKeys zobristKeys = generateKeys();
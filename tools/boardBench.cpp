@@ -0,0 +1,128 @@
+/**
+ * @file boardBench.cpp
+ * @author Seán Rourke
+ * @brief Microbenchmark for the cost of copying a board and of making moves.
+ * @date 2025
+ *
+ * Usage: boardBench [iterations]
+ *
+ * For each test position, times copying the board, making and unmaking every
+ * legal move, and copying the board then making each move on the copy (the
+ * pattern a copy-make search would use). Results are in nanoseconds per
+ * operation, so changes to the Board layout can be compared directly.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "attacks.h"
+#include "board.h"
+#include "makeMove.h"
+#include "moveGeneration.h"
+
+namespace
+{
+    const std::vector<std::string> positions = {
+        START_FEN,
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    };
+
+    /**
+     * @brief Times a function and returns the nanoseconds taken per operation.
+     *
+     * @param operations The number of operations the function performs.
+     * @param function The code being timed.
+     * @return double Nanoseconds per operation.
+     */
+    template <typename Function>
+    double nanosecondsPer(uint64_t operations, Function function)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / operations;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t iterations = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    initialiseAttackTables();
+
+    std::vector<Board> boards(positions.size());
+    std::vector<MoveList> moveLists(positions.size());
+    uint64_t movesPerIteration = 0;
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        boards[i].loadFEN(positions[i]);
+        generateMoves(boards[i].currentColour, boards[i], moveLists[i]);
+        movesPerIteration += moveLists[i].size();
+    }
+
+    uint64_t checksum = 0;
+
+    double copyTime = nanosecondsPer(iterations * positions.size(), [&]()
+    {
+        for (uint64_t n = 0; n < iterations; ++n)
+        {
+            for (const Board &board : boards)
+            {
+                Board copy = board;
+                // Make the copy observable so it is not optimised away
+                asm volatile("" : : "r"(&copy) : "memory");
+                checksum += copy.hashKey;
+            }
+        }
+    });
+
+    double makeUnmakeTime = nanosecondsPer(iterations * movesPerIteration, [&]()
+    {
+        for (uint64_t n = 0; n < iterations; ++n)
+        {
+            for (std::size_t i = 0; i < boards.size(); ++i)
+            {
+                for (const Move &move : moveLists[i])
+                {
+                    MoveHistory history = makeMove(boards[i], move);
+                    checksum += boards[i].hashKey;
+                    unmakeMove(boards[i], history);
+                }
+            }
+        }
+    });
+
+    double copyMakeTime = nanosecondsPer(iterations * movesPerIteration, [&]()
+    {
+        for (uint64_t n = 0; n < iterations; ++n)
+        {
+            for (std::size_t i = 0; i < boards.size(); ++i)
+            {
+                for (const Move &move : moveLists[i])
+                {
+                    Board copy = boards[i];
+                    makeMove(copy, move);
+                    checksum += copy.hashKey;
+                }
+            }
+        }
+    });
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "sizeof(Board):     " << sizeof(Board) << " bytes\n";
+    std::cout << "Board copy:        " << copyTime << " ns\n";
+    std::cout << "makeMove+unmake:   " << makeUnmakeTime << " ns\n";
+    std::cout << "copy+makeMove:     " << copyMakeTime << " ns\n";
+    std::cout << "(checksum " << checksum << ")" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * @file perftSuite.cpp
+ * @author Seán Rourke
+ * @brief Runs the standard perft positions and checks the node counts.
+ * @date 2025
+ *
+ * Usage: perftSuite [maxDepth] [threads] [hashMB] [splitDepth]
+ *
+ * Each position is counted from depth 1 up to maxDepth (default 5), or as far
+ * as its expected counts are listed. With more than one thread (default 1) or
+ * a hash size in megabytes (default 0, no hash), the parallel perft is used,
+ * splitting the tree splitDepth plies below the root (default 2). The time
+ * and nodes per second are printed for each depth so move generation speed
+ * can be tracked between changes. The exit code is non-zero if any count does
+ * not match.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "attacks.h"
+#include "board.h"
+#include "perft.h"
+
+/**
+ * @struct PerftPosition
+ * @brief A test position and its published perft counts.
+ */
+struct PerftPosition
+{
+    std::string name;              ///< Name the position is reported under.
+    std::string fen;               ///< The position in FEN.
+    std::vector<uint64_t> counts;  ///< Expected leaf counts for depth 1, 2, ...
+};
+
+/**
+ * @brief The standard perft suite from the Chess Programming Wiki.
+ */
+const std::vector<PerftPosition> suite = {
+    {"startpos", START_FEN,
+     {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+     {48, 2039, 97862, 4085603, 193690690}},
+    {"position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+     {14, 191, 2812, 43238, 674624, 11030083, 178633661}},
+    {"position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+     {6, 264, 9467, 422333, 15833292, 706045033}},
+    {"position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+     {44, 1486, 62379, 2103487, 89941194}},
+    {"position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+     {46, 2079, 89890, 3894594, 164075551, 6923051137}},
+};
+
+int main(int argc, char *argv[])
+{
+    int maxDepth = (argc > 1) ? std::atoi(argv[1]) : 5;
+    int threads = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 1;
+    int hashMB = (argc > 3) ? std::max(0, std::atoi(argv[3])) : 0;
+    int splitDepth = (argc > 4) ? std::max(0, std::atoi(argv[4])) : 2;
+
+    initialiseAttackTables();
+
+    bool parallel = threads > 1 || hashMB > 0;
+    std::unique_ptr<PerftTable> table;
+    if (hashMB > 0)
+    {
+        table.reset(new PerftTable(hashMB));
+    }
+
+    std::cout << "Threads: " << threads << ", hash: " << hashMB << " MB";
+    if (parallel)
+    {
+        std::cout << ", split depth: " << splitDepth;
+    }
+    std::cout << "\n\n";
+
+    bool passed = true;
+    uint64_t totalNodes = 0;
+    double totalSeconds = 0;
+
+    for (const PerftPosition &position : suite)
+    {
+        Board board;
+        board.loadFEN(position.fen);
+
+        for (int depth = 1; depth <= maxDepth && depth <= static_cast<int>(position.counts.size()); ++depth)
+        {
+            auto start = std::chrono::steady_clock::now();
+            uint64_t nodes = parallel ? parallelPerft(board, depth, threads, splitDepth, table.get())
+                                      : perft(board, depth);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            uint64_t expected = position.counts[depth - 1];
+            bool match = nodes == expected;
+            passed = passed && match;
+            totalNodes += nodes;
+            totalSeconds += seconds;
+
+            std::cout << std::left << std::setw(10) << position.name
+                      << " depth " << depth
+                      << std::right << std::setw(12) << nodes
+                      << (match ? "  ok      " : "  FAILED  ")
+                      << std::fixed << std::setprecision(3) << seconds << " s  "
+                      << static_cast<uint64_t>(nodes / std::max(seconds, 1e-9)) << " nps";
+            if (!match)
+            {
+                std::cout << "  (expected " << expected << ")";
+            }
+            std::cout << '\n';
+        }
+    }
+
+    std::cout << "\nTotal: " << totalNodes << " nodes in " << std::fixed << std::setprecision(3) << totalSeconds
+              << " s (" << static_cast<uint64_t>(totalNodes / std::max(totalSeconds, 1e-9)) << " nps)\n";
+    std::cout << (passed ? "All perft counts match." : "Perft count mismatch!") << std::endl;
+
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
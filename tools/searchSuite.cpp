@@ -0,0 +1,93 @@
+/**
+ * @file searchSuite.cpp
+ * @author Seán Rourke
+ * @brief Checks that the search stays inside its per-ply tables at the ply limit.
+ * @date 2025
+ *
+ * Usage: searchSuite
+ *
+ * Runs quiescence and alpha-beta on positions where the side to move is in
+ * check, starting close to MAX_PLY so that a run of evasions reaches the
+ * limit. At the last ply the search must return the static evaluation rather
+ * than search the evasions one ply deeper. The exit code is non-zero if any
+ * check fails.
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "attacks.h"
+#include "board.h"
+#include "evaluation.h"
+#include "search.h"
+
+namespace
+{
+    const std::string QUEEN_CHECK_FEN = "4k3/8/8/8/8/8/3q4/4K3 w - - 0 1"; ///< White is in check and can take the queen.
+    const std::string CHECKS_FEN = "6k1/5ppp/8/8/8/8/5PPP/3QR1K1 b - - 0 1"; ///< White has a run of checks on the back rank.
+
+    /**
+     * @brief Makes a search context for the calling thread, with no clock and nothing stopped.
+     *
+     * @param signals The signals the context reads.
+     * @return std::unique_ptr<SearchContext> The context.
+     */
+    std::unique_ptr<SearchContext> makeContext(SearchSignals &signals)
+    {
+        std::unique_ptr<SearchContext> context(new SearchContext());
+        context->signals = &signals;
+        return context;
+    }
+
+    /**
+     * @brief Prints the outcome of one check.
+     *
+     * @param name The name of the check.
+     * @param passed Whether it passed.
+     * @return bool The same passed value.
+     */
+    bool report(const std::string &name, bool passed)
+    {
+        std::cout << (passed ? "ok      " : "FAILED  ") << name << '\n';
+        return passed;
+    }
+}
+
+int main()
+{
+    initialiseAttackTables();
+    initialiseSearch();
+
+    SearchSignals signals;
+    bool passed = true;
+
+    {
+        // In check on the last ply: the evasion Kxd2 must not be searched
+        Board board;
+        board.loadFEN(QUEEN_CHECK_FEN);
+        std::unique_ptr<SearchContext> context = makeContext(signals);
+
+        Score expected = evaluation(board, context->pawnTable);
+        Score score = quiescence(*context, board, MAX_PLY - 1, -SCORE_INFINITE, SCORE_INFINITE);
+        passed &= report("quiescence in check at the ply limit returns the static evaluation", score == expected);
+    }
+
+    {
+        // Checks and evasions from a few plies short of the limit run into it
+        Board board;
+        board.loadFEN(CHECKS_FEN);
+        uint64_t hash = board.hashKey;
+        std::unique_ptr<SearchContext> context = makeContext(signals);
+
+        Score score = alphaBeta(*context, board, 4, MAX_PLY - 5, -SCORE_INFINITE, SCORE_INFINITE);
+        bool bounded = score > -SCORE_INFINITE && score < SCORE_INFINITE;
+        passed &= report("alpha-beta through a run of checks stops at the ply limit", bounded && board.hashKey == hash);
+    }
+
+    std::cout << (passed ? "All search checks passed." : "Search check failed!") << std::endl;
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}